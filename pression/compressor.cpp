@@ -192,6 +192,15 @@ void Compressor::compress(void* const in, const uint64_t inDims[2])
                             EQ_COMPRESSOR_DATA_1D);
 }
 
+bool Compressor::setParameter(const uint32_t parameter, const uint64_t value)
+{
+    if (!isGood() || !impl_->plugin->setParameter)
+        return false;
+
+    return impl_->plugin->setParameter(impl_->instance, impl_->info.name,
+                                       parameter, value);
+}
+
 unsigned Compressor::getNumResults() const
 {
     LBASSERT(impl_->plugin);
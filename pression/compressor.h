@@ -135,6 +135,21 @@ public:
     PRESSION_API void compress(void* const in, const uint64_t pvp[4],
                                uint64_t flags);
 
+    /**
+     * Set a parameter used by the following compressions.
+     *
+     * Parameters are reset when a new instance is set up or reallocated.
+     *
+     * @param parameter the parameter to set, one of
+     *                  EQ_COMPRESSOR_PARAMETER_*.
+     * @param value the new value of the parameter.
+     * @return true if the parameter was set, false if the compressor does not
+     *         support the parameter or value.
+     * @sa EqCompressorSetParameter()
+     * @version 2.1
+     */
+    PRESSION_API bool setParameter(uint32_t parameter, uint64_t value);
+
     /** @deprecated use new getResult()
      * @return the number of compressed chunks of the last compression.
      * @version 1.7.1
@@ -165,6 +165,16 @@ void EqCompressorDecompress(void* const decompressor, const unsigned name,
                          decompressor);
 }
 
+bool EqCompressorSetParameter(void* const ptr, const unsigned,
+                              const unsigned parameter,
+                              const eq_uint64_t value)
+{
+    assert(ptr);
+    pression::plugin::Compressor* compressor =
+        reinterpret_cast<pression::plugin::Compressor*>(ptr);
+    return compressor->setParameter(parameter, value);
+}
+
 bool EqCompressorIsCompatible(const unsigned name,
                               const GLEWContext* glewContext)
 {
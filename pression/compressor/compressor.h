@@ -87,6 +87,20 @@ public:
         LBDONTCALL;
     };
 
+    /**
+     * Set a compression parameter.
+     *
+     * @param parameter the parameter to set, one of
+     *                  EQ_COMPRESSOR_PARAMETER_*.
+     * @param value the new value of the parameter.
+     * @return true if the parameter was set, false otherwise.
+     */
+    virtual bool setParameter(const unsigned parameter LB_UNUSED,
+                              const eq_uint64_t value LB_UNUSED)
+    {
+        return false;
+    }
+
     typedef lunchbox::Bufferb Result;
     typedef std::vector<Result*> ResultVector;
 
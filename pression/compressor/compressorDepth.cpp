@@ -0,0 +1,251 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorDepth.h"
+
+#include <algorithm>
+
+namespace pression
+{
+namespace plugin
+{
+namespace
+{
+#define REGISTER_ENGINE(type, ratio_, speed_)                                \
+    static void _getInfoPredict##type(EqCompressorInfo* const info)          \
+    {                                                                        \
+        info->version = EQ_COMPRESSOR_VERSION;                               \
+        info->capabilities = EQ_COMPRESSOR_DATA_1D | EQ_COMPRESSOR_DATA_2D;  \
+        info->quality = 1.f;                                                 \
+        info->ratio = ratio_##f;                                             \
+        info->speed = speed_##f;                                             \
+        info->name = EQ_COMPRESSOR_PREDICT_##type;                           \
+        info->tokenType = EQ_COMPRESSOR_DATATYPE_##type;                     \
+    }                                                                        \
+                                                                             \
+    static bool _registerPredict##type()                                     \
+    {                                                                        \
+        Compressor::registerEngine(                                          \
+            Compressor::Functions(EQ_COMPRESSOR_PREDICT_##type,              \
+                                  _getInfoPredict##type,                     \
+                                  CompressorDepth::getNewCompressor,         \
+                                  CompressorDepth::getNewDecompressor,       \
+                                  CompressorDepth::decompress, 0));          \
+        return true;                                                         \
+    }                                                                        \
+                                                                             \
+    static const bool LB_UNUSED _initializedPredict##type =                  \
+        _registerPredict##type();
+
+REGISTER_ENGINE(DEPTH_UNSIGNED_INT, .3, .8);
+
+const eq_uint64_t _stripeHeight = 64; // rows compressed independently
+const eq_uint64_t _maxSymbolSize = 5; // bytes of a residual symbol
+
+/** The first result, followed by one result per stripe. */
+struct Header
+{
+    eq_uint64_t width;
+    eq_uint64_t height;
+};
+
+// Predicts the value at x from the plane through its left, upper and upper
+// left neighbours. The first row of a stripe has no upper neighbours and is
+// extrapolated linearly from the two left neighbours.
+inline uint32_t _predict(const uint32_t* const previous,
+                         const uint32_t* const current, const eq_uint64_t x)
+{
+    if (!previous)
+    {
+        if (x > 1)
+            return 2 * current[x - 1] - current[x - 2];
+        return x ? current[x - 1] : 0;
+    }
+    if (!x)
+        return previous[0];
+    return current[x - 1] + previous[x] - previous[x - 1];
+}
+
+// Maps residuals to unsigned values by magnitude: 0, -1, 1, -2, 2, ...
+inline uint32_t _map(const uint32_t residual)
+{
+    return (residual << 1) ^ uint32_t(int32_t(residual) >> 31);
+}
+
+inline uint32_t _unmap(const uint32_t value)
+{
+    return (value >> 1) ^ (0u - (value & 1));
+}
+
+// A symbol is a mapped residual shifted left by one, or a run length shifted
+// left by one with the lowest bit set. It is written in groups of seven bits,
+// lowest first, with the highest bit of each byte flagging a following byte.
+inline uint8_t* _write(uint64_t symbol, uint8_t* out)
+{
+    for (; symbol >= 0x80; symbol >>= 7)
+        *out++ = uint8_t(symbol) | 0x80;
+    *out++ = uint8_t(symbol);
+    return out;
+}
+
+inline const uint8_t* _read(const uint8_t* in, uint64_t& symbol)
+{
+    symbol = 0;
+    for (unsigned shift = 0;; shift += 7)
+    {
+        const uint8_t byte = *in++;
+        symbol |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return in;
+    }
+}
+
+void _compressStripe(const uint32_t* const in, const eq_uint64_t width,
+                     const eq_uint64_t nRows, Compressor::Result& result)
+{
+    // A run of n values never takes more space than n residuals
+    result.reserve(width * nRows * _maxSymbolSize);
+    uint8_t* const start = result.getData();
+    uint8_t* out = start;
+    uint64_t run = 0;
+
+    for (eq_uint64_t y = 0; y < nRows; ++y)
+    {
+        const uint32_t* const previous = y ? in + (y - 1) * width : 0;
+        const uint32_t* const current = in + y * width;
+        for (eq_uint64_t x = 0; x < width; ++x)
+        {
+            const uint32_t residual =
+                current[x] - _predict(previous, current, x);
+            if (residual == 0)
+            {
+                ++run;
+                continue;
+            }
+            if (run)
+            {
+                out = _write(run << 1 | 1, out);
+                run = 0;
+            }
+            out = _write(uint64_t(_map(residual)) << 1, out);
+        }
+    }
+
+    if (run)
+        out = _write(run << 1 | 1, out);
+    result.setSize(out - start);
+}
+
+void _decompressStripe(const uint8_t* in, const eq_uint64_t inSize LB_UNUSED,
+                       const eq_uint64_t width, const eq_uint64_t nRows,
+                       uint32_t* const out)
+{
+#ifndef NDEBUG
+    const uint8_t* const end = in + inSize;
+#endif
+    uint64_t run = 0;
+
+    for (eq_uint64_t y = 0; y < nRows; ++y)
+    {
+        const uint32_t* const previous = y ? out + (y - 1) * width : 0;
+        uint32_t* const current = out + y * width;
+        for (eq_uint64_t x = 0; x < width; ++x)
+        {
+            const uint32_t prediction = _predict(previous, current, x);
+            if (run == 0)
+            {
+                assert(in < end);
+                uint64_t symbol;
+                in = _read(in, symbol);
+                if (!(symbol & 1))
+                {
+                    current[x] = prediction + _unmap(uint32_t(symbol >> 1));
+                    continue;
+                }
+                run = symbol >> 1;
+            }
+            --run;
+            current[x] = prediction;
+        }
+    }
+    assert(in == end);
+}
+
+eq_uint64_t _getNumStripes(const Header& header)
+{
+    return (header.height + _stripeHeight - 1) / _stripeHeight;
+}
+
+eq_uint64_t _getNumRows(const Header& header, const eq_uint64_t stripe)
+{
+    return std::min(_stripeHeight, header.height - stripe * _stripeHeight);
+}
+}
+
+void CompressorDepth::compress(const void* const inData,
+                               const eq_uint64_t* inDims,
+                               const eq_uint64_t flags)
+{
+    Header header;
+    header.width = inDims[1];
+    header.height = (flags & EQ_COMPRESSOR_DATA_1D) ? 1 : inDims[3];
+
+    const eq_uint64_t nStripes = _getNumStripes(header);
+    _nResults = unsigned(1 + nStripes);
+    while (_results.size() < _nResults)
+        _results.push_back(new Result);
+    _results[0]->replace(&header, sizeof(header));
+
+    const uint32_t* const in = reinterpret_cast<const uint32_t*>(inData);
+    const eq_uint64_t stripeSize = _stripeHeight * header.width;
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nStripes); ++i)
+        _compressStripe(in + i * stripeSize, header.width,
+                        _getNumRows(header, i), *_results[i + 1]);
+}
+
+void CompressorDepth::decompress(const void* const* inData,
+                                 const eq_uint64_t* const inSizes,
+                                 const unsigned nInputs LB_UNUSED,
+                                 void* const outData,
+                                 eq_uint64_t* const outDims LB_UNUSED,
+                                 const eq_uint64_t flags LB_UNUSED,
+                                 void* const)
+{
+    assert(nInputs > 0 && inSizes[0] == sizeof(Header));
+    Header header;
+    ::memcpy(&header, inData[0], sizeof(header));
+    assert(nInputs == 1 + _getNumStripes(header));
+    assert(header.width == outDims[1]);
+    assert(header.height ==
+           ((flags & EQ_COMPRESSOR_DATA_1D) ? 1 : outDims[3]));
+
+    uint32_t* const out = reinterpret_cast<uint32_t*>(outData);
+    const eq_uint64_t stripeSize = _stripeHeight * header.width;
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(_getNumStripes(header));
+         ++i)
+    {
+        _decompressStripe(reinterpret_cast<const uint8_t*>(inData[i + 1]),
+                          inSizes[i + 1], header.width, _getNumRows(header, i),
+                          out + i * stripeSize);
+    }
+}
+}
+}
@@ -0,0 +1,62 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef PRESSION_PLUGIN_COMPRESSORDEPTH
+#define PRESSION_PLUGIN_COMPRESSORDEPTH
+
+#include "compressor.h"
+
+namespace pression
+{
+namespace plugin
+{
+/**
+ * Lossless predictive compression of 32 bit depth values.
+ *
+ * The depth of rasterized geometry is linear in screen space, so each value is
+ * predicted from the plane through its left, upper and upper left neighbours.
+ * Residuals are written as variable length integers of one to five bytes, and
+ * runs of exactly predicted values, like the cleared background, as a single
+ * run length. Stripes of rows are compressed into separate results in
+ * parallel.
+ */
+class CompressorDepth : public Compressor
+{
+public:
+    CompressorDepth()
+        : Compressor()
+    {
+    }
+    virtual ~CompressorDepth() {}
+    using Compressor::compress;
+    void compress(const void* const inData, const eq_uint64_t* inDims,
+                  const eq_uint64_t flags) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorDepth;
+    }
+};
+}
+}
+#endif // PRESSION_PLUGIN_COMPRESSORDEPTH
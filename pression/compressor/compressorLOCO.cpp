@@ -0,0 +1,558 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorLOCO.h"
+
+#include <algorithm>
+
+namespace pression
+{
+namespace plugin
+{
+namespace
+{
+#define REGISTER_ENGINE(type, ratio_, speed_, alpha)                         \
+    static void _getInfoLOCO##type(EqCompressorInfo* const info)             \
+    {                                                                        \
+        info->version = EQ_COMPRESSOR_VERSION;                               \
+        info->capabilities = EQ_COMPRESSOR_DATA_1D | EQ_COMPRESSOR_DATA_2D;  \
+        if (alpha)                                                           \
+            info->capabilities |= EQ_COMPRESSOR_IGNORE_ALPHA;                \
+        info->quality = 1.f;                                                 \
+        info->ratio = ratio_##f;                                             \
+        info->speed = speed_##f;                                             \
+        info->name = EQ_COMPRESSOR_LOCO_##type;                              \
+        info->tokenType = EQ_COMPRESSOR_DATATYPE_##type;                     \
+    }                                                                        \
+                                                                             \
+    static bool _registerLOCO##type()                                        \
+    {                                                                        \
+        Compressor::registerEngine(                                          \
+            Compressor::Functions(EQ_COMPRESSOR_LOCO_##type,                 \
+                                  _getInfoLOCO##type,                        \
+                                  CompressorLOCO::getNewCompressor,          \
+                                  CompressorLOCO::getNewDecompressor,        \
+                                  CompressorLOCO::decompress, 0));           \
+        return true;                                                         \
+    }                                                                        \
+                                                                             \
+    static const bool LB_UNUSED _initializedLOCO##type =                     \
+        _registerLOCO##type();
+
+// The RGBA and BGRA engines rate below the RLE engines. No other lossless
+// engine compresses RGB and BGR, where the rating has to stay below the
+// uncompressed transfer for Compressor::choose() to keep it as the default.
+REGISTER_ENGINE(RGBA, .3, .1, true);
+REGISTER_ENGINE(BGRA, .3, .1, true);
+REGISTER_ENGINE(RGB, .3, .01, false);
+REGISTER_ENGINE(BGR, .3, .01, false);
+
+const eq_uint64_t _stripeHeight = 64; // rows compressed independently
+const unsigned _limit = 24;    // unary code length escaping to a raw value
+const unsigned _nContexts = 8; // gradient contexts per component
+const uint32_t _reset = 64;    // halves the statistics of a context
+
+/** The first result, followed by one result per stripe. */
+struct Header
+{
+    eq_uint64_t width;
+    eq_uint64_t height;
+    eq_uint64_t pixelSize; //!< bytes per pixel
+    eq_uint64_t nChannels; //!< components coded per pixel
+};
+
+/** Running mean of the coded values, giving the Golomb-Rice parameter. */
+struct Context
+{
+    Context()
+        : sum(4)
+        , count(1)
+    {
+    }
+
+    unsigned getK() const
+    {
+        unsigned k = 0;
+        while ((uint64_t(count) << k) < sum)
+            ++k;
+        return k;
+    }
+
+    void update(const uint32_t value)
+    {
+        sum += value;
+        if (++count == _reset)
+        {
+            sum >>= 1;
+            count >>= 1;
+        }
+    }
+
+    uint32_t sum;
+    uint32_t count;
+};
+
+/** The adaptive state of a stripe, reset at its start. */
+struct Contexts
+{
+    Context pixel[4][_nContexts];
+    Context run;
+};
+
+class BitWriter
+{
+public:
+    explicit BitWriter(Compressor::Result& result)
+        : _result(result)
+        , _size(0)
+        , _bits(0)
+        , _nBits(0)
+    {
+        _result.setSize(0);
+    }
+
+    /** Ensure space for writing the given number of bytes. */
+    void reserve(const uint64_t size)
+    {
+        if (_result.getMaxSize() < _size + size)
+            _result.reserve(std::max(_size + size, _result.getMaxSize() * 2));
+    }
+
+    /** Write nBits <= 32 bits of value, LSB first. */
+    void write(const uint32_t value, const unsigned nBits)
+    {
+        _bits |= uint64_t(value) << _nBits;
+        _nBits += nBits;
+        if (_nBits < 32)
+            return;
+
+        const uint32_t word = uint32_t(_bits);
+        ::memcpy(_result.getData() + _size, &word, sizeof(word));
+        _size += sizeof(word);
+        _bits >>= 32;
+        _nBits -= 32;
+    }
+
+    /** Write a Golomb-Rice code, or an escaped value of rawBits bits. */
+    void writeRice(const uint32_t value, const unsigned k,
+                   const unsigned rawBits)
+    {
+        const uint32_t quotient = value >> k;
+        if (quotient < _limit && quotient + 1 + k <= 32)
+            write((value & ((uint64_t(1) << k) - 1)) << (quotient + 1) |
+                      1u << quotient,
+                  quotient + 1 + k);
+        else if (quotient < _limit)
+        {
+            write(1u << quotient, quotient + 1);
+            write(value & ((uint64_t(1) << k) - 1), k);
+        }
+        else
+        {
+            write(1u << _limit, _limit + 1);
+            write(value, rawBits);
+        }
+    }
+
+    /** Write the remaining bits and set the size of the result. */
+    void flush()
+    {
+        for (; _nBits > 0; _nBits -= std::min(_nBits, 8u), _bits >>= 8)
+            _result.getData()[_size++] = uint8_t(_bits);
+        _result.setSize(_size);
+    }
+
+private:
+    Compressor::Result& _result;
+    uint64_t _size;
+    uint64_t _bits;
+    unsigned _nBits;
+};
+
+class BitReader
+{
+public:
+    BitReader(const void* const data, const uint64_t size)
+        : _in(reinterpret_cast<const uint8_t*>(data))
+        , _end(_in + size)
+        , _bits(0)
+        , _nBits(0)
+    {
+    }
+
+    /** Buffer at least 56 bits, padding the input with zeros. */
+    void refill()
+    {
+        if (_end - _in >= 8)
+        {
+            uint64_t word;
+            ::memcpy(&word, _in, sizeof(word));
+            _bits |= word << _nBits;
+            _in += (63 - _nBits) >> 3;
+            _nBits |= 56;
+            return;
+        }
+        for (; _nBits <= 56; _nBits += 8)
+            _bits |= uint64_t(_in < _end ? *_in++ : 0) << _nBits;
+    }
+
+    /** Read nBits <= 32 buffered bits. */
+    uint32_t read(const unsigned nBits)
+    {
+        const uint32_t value = uint32_t(_bits & ((uint64_t(1) << nBits) - 1));
+        _bits >>= nBits;
+        _nBits -= nBits;
+        return value;
+    }
+
+    uint32_t readRice(const unsigned k, const unsigned rawBits)
+    {
+        refill();
+        const unsigned quotient = _countZeros(_bits | (uint64_t(1) << _limit));
+        read(quotient + 1);
+        if (quotient < _limit)
+            return (quotient << k) | read(k);
+
+        refill();
+        return read(rawBits);
+    }
+
+private:
+    const uint8_t* _in;
+    const uint8_t* const _end;
+    uint64_t _bits;
+    unsigned _nBits;
+
+    static unsigned _countZeros(const uint64_t value)
+    {
+#ifdef HAVE_BUILTIN_CTZ
+        return __builtin_ctzll(value);
+#else
+        unsigned count = 0;
+        while (!(value & (uint64_t(1) << count)))
+            ++count;
+        return count;
+#endif
+    }
+};
+
+// Pixels are packed into 32 bits with red and blue relative to green
+template <size_t pixelSize>
+inline uint32_t _load(const uint8_t* const in, const uint32_t alphaMask)
+{
+    const uint32_t green = in[1];
+    uint32_t pixel = uint8_t(in[0] - green) | green << 8 |
+                     uint32_t(uint8_t(in[2] - green)) << 16;
+    if (pixelSize == 4)
+        pixel |= (uint32_t(in[3]) << 24) & alphaMask;
+    return pixel;
+}
+
+template <size_t pixelSize>
+inline void _store(const uint32_t pixel, uint8_t* const out)
+{
+    const uint8_t green = uint8_t(pixel >> 8);
+    out[0] = uint8_t(pixel + green);
+    out[1] = green;
+    out[2] = uint8_t((pixel >> 16) + green);
+    if (pixelSize == 4)
+        out[3] = uint8_t(pixel >> 24);
+}
+
+// The median edge detector of LOCO-I
+inline int _predict(const int a, const int b, const int c)
+{
+    const int minAB = std::min(a, b);
+    const int maxAB = std::max(a, b);
+    if (c >= maxAB)
+        return minAB;
+    if (c <= minAB)
+        return maxAB;
+    return a + b - c;
+}
+
+// Quantizes the local gradient into the contexts 0, 1-2, 3-6, ..., 127-
+inline unsigned _getContext(const int a, const int b, const int c,
+                            const int d)
+{
+    const unsigned gradient =
+        std::abs(d - b) + std::abs(b - c) + std::abs(c - a) + 1;
+#ifdef HAVE_BUILTIN_CTZ
+    const unsigned context = 31 - __builtin_clz(gradient);
+#else
+    unsigned context = 0;
+    while (gradient >> (context + 1))
+        ++context;
+#endif
+    return std::min(context, _nContexts - 1);
+}
+
+// Maps residuals -128..127 to 0..255 by magnitude
+inline uint32_t _map(const int8_t residual)
+{
+    return residual >= 0 ? uint32_t(residual) << 1
+                         : (uint32_t(-residual) << 1) - 1;
+}
+
+inline uint8_t _unmap(const uint32_t value)
+{
+    return uint8_t((value & 1) ? ~(value >> 1) : value >> 1);
+}
+
+// Sets the left, upper, upper left and upper right neighbours of x. The rows
+// are padded by one pixel on each side, replicating their edge pixels.
+inline void _getNeighbours(const uint32_t* const previous,
+                           const uint32_t* const current, const eq_uint64_t x,
+                           uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d)
+{
+    a = x ? current[x - 1] : previous[0];
+    b = previous[x];
+    c = previous[x - 1];
+    d = previous[x + 1];
+}
+
+inline int _get(const uint32_t pixel, const size_t channel)
+{
+    return (pixel >> (channel * 8)) & 0xff;
+}
+
+void _compressRow(const uint32_t* const previous, const uint32_t* const current,
+                  const eq_uint64_t width, const size_t nChannels,
+                  Contexts& contexts, BitWriter& writer)
+{
+    for (eq_uint64_t x = 0; x < width; ++x)
+    {
+        uint32_t a, b, c, d;
+        _getNeighbours(previous, current, x, a, b, c, d);
+        if (a == b && b == c && c == d)
+        {
+            eq_uint64_t length = 0;
+            while (x + length < width && current[x + length] == a)
+                ++length;
+            writer.writeRice(uint32_t(length), contexts.run.getK(), 32);
+            contexts.run.update(uint32_t(length));
+
+            x += length;
+            if (x == width)
+                return;
+            _getNeighbours(previous, current, x, a, b, c, d);
+        }
+
+        for (size_t i = 0; i < nChannels; ++i)
+        {
+            const int ca = _get(a, i);
+            const int cb = _get(b, i);
+            const int cc = _get(c, i);
+            Context& context =
+                contexts.pixel[i][_getContext(ca, cb, cc, _get(d, i))];
+            const uint32_t value = _map(
+                int8_t(uint8_t(_get(current[x], i) - _predict(ca, cb, cc))));
+            writer.writeRice(value, context.getK(), 8);
+            context.update(value);
+        }
+    }
+}
+
+void _decompressRow(const uint32_t* const previous, uint32_t* const current,
+                    const eq_uint64_t width, const size_t nChannels,
+                    Contexts& contexts, BitReader& reader)
+{
+    for (eq_uint64_t x = 0; x < width; ++x)
+    {
+        uint32_t a, b, c, d;
+        _getNeighbours(previous, current, x, a, b, c, d);
+        if (a == b && b == c && c == d)
+        {
+            const uint32_t length = reader.readRice(contexts.run.getK(), 32);
+            contexts.run.update(length);
+            if (length > width - x)
+            {
+                LBWARN << "Corrupt LOCO run of " << length << " pixels at "
+                       << x << " in a row of " << width << std::endl;
+                std::fill(current + x, current + width, a);
+                return;
+            }
+
+            std::fill(current + x, current + x + length, a);
+            x += length;
+            if (x == width)
+                return;
+            _getNeighbours(previous, current, x, a, b, c, d);
+        }
+
+        uint32_t pixel = 0;
+        for (size_t i = 0; i < nChannels; ++i)
+        {
+            const int ca = _get(a, i);
+            const int cb = _get(b, i);
+            const int cc = _get(c, i);
+            Context& context =
+                contexts.pixel[i][_getContext(ca, cb, cc, _get(d, i))];
+            const uint32_t value = reader.readRice(context.getK(), 8);
+            context.update(value);
+            pixel |= uint32_t(uint8_t(_unmap(value) + _predict(ca, cb, cc)))
+                     << (i * 8);
+        }
+        current[x] = pixel;
+    }
+}
+
+// Replicates the edge pixels of a row into its padding
+inline void _pad(uint32_t* const row, const eq_uint64_t width)
+{
+    row[-1] = row[0];
+    row[width] = row[width - 1];
+}
+
+template <size_t pixelSize>
+void _compressStripe(const uint8_t* in, const Header& header,
+                     const eq_uint64_t nRows, Compressor::Result& result)
+{
+    const eq_uint64_t width = header.width;
+    const uint32_t alphaMask = header.nChannels == 4 ? 0xffffffffu : 0xffffffu;
+    std::vector<uint32_t> rows(2 * (width + 2), 0);
+    uint32_t* previous = &rows[1];
+    uint32_t* current = &rows[width + 3];
+    Contexts contexts;
+    BitWriter writer(result);
+
+    for (eq_uint64_t y = 0; y < nRows; ++y)
+    {
+        for (eq_uint64_t x = 0; x < width; ++x, in += pixelSize)
+            current[x] = _load<pixelSize>(in, alphaMask);
+        _pad(current, width);
+
+        // worst case of a run and escaped components for each pixel
+        writer.reserve(width * 24 + 8);
+        _compressRow(previous, current, width, header.nChannels, contexts,
+                     writer);
+        std::swap(previous, current);
+    }
+    writer.flush();
+}
+
+template <size_t pixelSize>
+void _decompressStripe(const void* const inData, const eq_uint64_t inSize,
+                       const Header& header, const eq_uint64_t nRows,
+                       uint8_t* out)
+{
+    const eq_uint64_t width = header.width;
+    std::vector<uint32_t> rows(2 * (width + 2), 0);
+    uint32_t* previous = &rows[1];
+    uint32_t* current = &rows[width + 3];
+    Contexts contexts;
+    BitReader reader(inData, inSize);
+
+    for (eq_uint64_t y = 0; y < nRows; ++y)
+    {
+        _decompressRow(previous, current, width, header.nChannels, contexts,
+                       reader);
+        _pad(current, width);
+        for (eq_uint64_t x = 0; x < width; ++x, out += pixelSize)
+            _store<pixelSize>(current[x], out);
+        std::swap(previous, current);
+    }
+}
+
+eq_uint64_t _getNumStripes(const Header& header)
+{
+    return (header.height + _stripeHeight - 1) / _stripeHeight;
+}
+
+eq_uint64_t _getNumRows(const Header& header, const eq_uint64_t stripe)
+{
+    return std::min(_stripeHeight, header.height - stripe * _stripeHeight);
+}
+}
+
+CompressorLOCO::CompressorLOCO(const unsigned name)
+    : Compressor()
+    , _pixelSize(name == EQ_COMPRESSOR_LOCO_RGB ||
+                         name == EQ_COMPRESSOR_LOCO_BGR
+                     ? 3
+                     : 4)
+{
+}
+
+void CompressorLOCO::compress(const void* const inData,
+                              const eq_uint64_t* inDims,
+                              const eq_uint64_t flags)
+{
+    Header header;
+    header.width = inDims[1];
+    header.height = (flags & EQ_COMPRESSOR_DATA_1D) ? 1 : inDims[3];
+    header.pixelSize = _pixelSize;
+    header.nChannels =
+        (_pixelSize == 4 && !(flags & EQ_COMPRESSOR_IGNORE_ALPHA)) ? 4 : 3;
+
+    const eq_uint64_t nStripes = _getNumStripes(header);
+    _nResults = unsigned(1 + nStripes);
+    while (_results.size() < _nResults)
+        _results.push_back(new Result);
+    _results[0]->replace(&header, sizeof(header));
+
+    const uint8_t* const in = reinterpret_cast<const uint8_t*>(inData);
+    const eq_uint64_t stripeSize = _stripeHeight * header.width * _pixelSize;
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nStripes); ++i)
+    {
+        const eq_uint64_t nRows = _getNumRows(header, i);
+        if (_pixelSize == 4)
+            _compressStripe<4>(in + i * stripeSize, header, nRows,
+                               *_results[i + 1]);
+        else
+            _compressStripe<3>(in + i * stripeSize, header, nRows,
+                               *_results[i + 1]);
+    }
+}
+
+void CompressorLOCO::decompress(const void* const* inData,
+                                const eq_uint64_t* const inSizes,
+                                const unsigned nInputs LB_UNUSED,
+                                void* const outData,
+                                eq_uint64_t* const outDims LB_UNUSED,
+                                const eq_uint64_t flags LB_UNUSED,
+                                void* const)
+{
+    assert(nInputs > 0 && inSizes[0] == sizeof(Header));
+    Header header;
+    ::memcpy(&header, inData[0], sizeof(header));
+    assert(nInputs == 1 + _getNumStripes(header));
+    assert(header.width == outDims[1]);
+    assert(header.height ==
+           ((flags & EQ_COMPRESSOR_DATA_1D) ? 1 : outDims[3]));
+
+    uint8_t* const out = reinterpret_cast<uint8_t*>(outData);
+    const eq_uint64_t stripeSize =
+        _stripeHeight * header.width * header.pixelSize;
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(_getNumStripes(header));
+         ++i)
+    {
+        const eq_uint64_t nRows = _getNumRows(header, i);
+        if (header.pixelSize == 4)
+            _decompressStripe<4>(inData[i + 1], inSizes[i + 1], header, nRows,
+                                 out + i * stripeSize);
+        else
+            _decompressStripe<3>(inData[i + 1], inSizes[i + 1], header, nRows,
+                                 out + i * stripeSize);
+    }
+}
+}
+}
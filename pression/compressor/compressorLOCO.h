@@ -0,0 +1,62 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef PRESSION_PLUGIN_COMPRESSORLOCO
+#define PRESSION_PLUGIN_COMPRESSORLOCO
+
+#include "compressor.h"
+
+namespace pression
+{
+namespace plugin
+{
+/**
+ * Lossless predictive compression of 8 bit color images, in the style of
+ * LOCO-I (JPEG-LS).
+ *
+ * Red and blue are coded relative to green. Each component is predicted from
+ * its left, upper and upper left neighbours with the median edge detector, and
+ * the residual is written with a Golomb-Rice code adapting to the local
+ * gradient. Runs of pixels in flat regions are coded as a single run length.
+ * Stripes of rows are compressed into separate results in parallel.
+ */
+class CompressorLOCO : public Compressor
+{
+public:
+    explicit CompressorLOCO(const unsigned name);
+    virtual ~CompressorLOCO() {}
+    using Compressor::compress;
+    void compress(const void* const inData, const eq_uint64_t* inDims,
+                  const eq_uint64_t flags) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned name)
+    {
+        return new CompressorLOCO(name);
+    }
+
+private:
+    const eq_uint64_t _pixelSize; //!< 3 for RGB, 4 for RGBA tokens
+};
+}
+}
+#endif // PRESSION_PLUGIN_COMPRESSORLOCO
@@ -0,0 +1,307 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorQOI.h"
+
+#include <algorithm>
+#ifdef PRESSION_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace pression
+{
+namespace plugin
+{
+namespace
+{
+#define REGISTER_ENGINE(type, ratio_, speed_)                                \
+    static void _getInfoQOI##type(EqCompressorInfo* const info)              \
+    {                                                                        \
+        info->version = EQ_COMPRESSOR_VERSION;                               \
+        info->capabilities = EQ_COMPRESSOR_DATA_1D | EQ_COMPRESSOR_DATA_2D | \
+                             EQ_COMPRESSOR_IGNORE_ALPHA;                     \
+        info->quality = 1.f;                                                 \
+        info->ratio = ratio_##f;                                             \
+        info->speed = speed_##f;                                             \
+        info->name = EQ_COMPRESSOR_QOI_##type;                               \
+        info->tokenType = EQ_COMPRESSOR_DATATYPE_##type;                     \
+    }                                                                        \
+                                                                             \
+    static bool _registerQOI##type()                                         \
+    {                                                                        \
+        Compressor::registerEngine(                                          \
+            Compressor::Functions(EQ_COMPRESSOR_QOI_##type,                  \
+                                  _getInfoQOI##type,                         \
+                                  CompressorQOI::getNewCompressor,           \
+                                  CompressorQOI::getNewDecompressor,         \
+                                  CompressorQOI::decompress, 0));            \
+        return true;                                                         \
+    }                                                                        \
+                                                                             \
+    static const bool LB_UNUSED _initializedQOI##type = _registerQOI##type();
+
+REGISTER_ENGINE(RGBA, .3, .9);
+REGISTER_ENGINE(BGRA, .3, .9);
+
+const uint8_t _opIndex = 0x00; // 00iiiiii: pixel from the cache
+const uint8_t _opDiff = 0x40;  // 01rrggbb: component differences -2..1
+const uint8_t _opLuma = 0x80;  // 10gggggg rrrrbbbb: green -32..31, red and
+                               // blue -8..7 relative to green
+const uint8_t _opRun = 0xc0;   // 11llllll: previous pixel 1..62 times
+const uint8_t _opRGB = 0xfe;   // red, green and blue bytes follow
+const uint8_t _opRGBA = 0xff;  // red, green, blue and alpha bytes follow
+const uint8_t _opMask = 0xc0;
+const uint32_t _maxRun = 62;
+const uint32_t _start = 0xff000000u; // opaque black precedes each chunk
+
+inline uint8_t _get(const uint32_t pixel, const unsigned component)
+{
+    return uint8_t(pixel >> (component * 8));
+}
+
+inline unsigned _hash(const uint32_t pixel)
+{
+    return (_get(pixel, 0) * 3 + _get(pixel, 1) * 5 + _get(pixel, 2) * 7 +
+            _get(pixel, 3) * 11) %
+           64;
+}
+
+// @return the pixel with the three color components increased by the deltas
+inline uint32_t _add(const uint32_t pixel, const int red, const int green,
+                     const int blue)
+{
+    return uint32_t(uint8_t(_get(pixel, 0) + red)) |
+           uint32_t(uint8_t(_get(pixel, 1) + green)) << 8 |
+           uint32_t(uint8_t(_get(pixel, 2) + blue)) << 16 |
+           (pixel & 0xff000000u);
+}
+
+// Determine the number of chunks as _setupResults() in compressorRLE.ipp does
+// for a single channel.
+unsigned _setupChunks(const eq_uint64_t nPixels,
+                      Compressor::ResultVector& results)
+{
+    const eq_uint64_t size = nPixels * sizeof(uint32_t);
+#ifdef PRESSION_USE_OPENMP
+    const eq_uint64_t cpuChunks = omp_get_num_procs();
+    const eq_uint64_t sizeChunks = std::max(size / 4096, eq_uint64_t(1));
+    const unsigned nChunks = unsigned(std::min(sizeChunks, cpuChunks));
+#else
+    const unsigned nChunks = 1;
+#endif
+
+    while (results.size() < nChunks)
+        results.push_back(new Compressor::Result);
+
+    // The worst case are five bytes for each pixel with a new alpha value
+    const eq_uint64_t maxChunkSize = (nPixels / nChunks + 1) * 5;
+    for (size_t i = 0; i < nChunks; ++i)
+        results[i]->reserve(maxChunkSize);
+
+    LBVERB << "Compressing " << size << " bytes in " << nChunks << " chunks"
+           << std::endl;
+    return nChunks;
+}
+
+// @return the first pixel of the given chunk
+inline eq_uint64_t _getChunkStart(const eq_uint64_t nPixels,
+                                  const unsigned nChunks, const unsigned chunk)
+{
+    return nPixels * chunk / nChunks;
+}
+
+template <bool useAlpha>
+void _compressChunk(const uint32_t* const in, const eq_uint64_t nPixels,
+                    Compressor::Result& result)
+{
+    uint32_t cache[64] = {0};
+    uint32_t previous = _start;
+    uint32_t run = 0;
+    uint8_t* const start = result.getData();
+    uint8_t* out = start;
+
+    for (eq_uint64_t i = 0; i < nPixels; ++i)
+    {
+        const uint32_t pixel = useAlpha ? in[i] : in[i] | 0xff000000u;
+        if (pixel == previous)
+        {
+            if (++run == _maxRun)
+            {
+                *out++ = _opRun | uint8_t(run - 1);
+                run = 0;
+            }
+            continue;
+        }
+        if (run)
+        {
+            *out++ = _opRun | uint8_t(run - 1);
+            run = 0;
+        }
+
+        const unsigned hash = _hash(pixel);
+        if (cache[hash] == pixel)
+        {
+            *out++ = _opIndex | uint8_t(hash);
+            previous = pixel;
+            continue;
+        }
+        cache[hash] = pixel;
+
+        if (useAlpha && (pixel ^ previous) >> 24)
+        {
+            *out++ = _opRGBA;
+            for (unsigned j = 0; j < 4; ++j)
+                *out++ = _get(pixel, j);
+            previous = pixel;
+            continue;
+        }
+
+        const int red = int8_t(_get(pixel, 0) - _get(previous, 0));
+        const int green = int8_t(_get(pixel, 1) - _get(previous, 1));
+        const int blue = int8_t(_get(pixel, 2) - _get(previous, 2));
+        const int redGreen = red - green;
+        const int blueGreen = blue - green;
+        if (red >= -2 && red <= 1 && green >= -2 && green <= 1 &&
+            blue >= -2 && blue <= 1)
+        {
+            *out++ = _opDiff | uint8_t((red + 2) << 4 | (green + 2) << 2 |
+                                       (blue + 2));
+        }
+        else if (green >= -32 && green <= 31 && redGreen >= -8 &&
+                 redGreen <= 7 && blueGreen >= -8 && blueGreen <= 7)
+        {
+            *out++ = _opLuma | uint8_t(green + 32);
+            *out++ = uint8_t((redGreen + 8) << 4 | (blueGreen + 8));
+        }
+        else
+        {
+            *out++ = _opRGB;
+            for (unsigned j = 0; j < 3; ++j)
+                *out++ = _get(pixel, j);
+        }
+        previous = pixel;
+    }
+
+    if (run)
+        *out++ = _opRun | uint8_t(run - 1);
+    result.setSize(out - start);
+}
+
+void _decompressChunk(const uint8_t* in, const eq_uint64_t inSize LB_UNUSED,
+                      uint32_t* const out, const eq_uint64_t nPixels)
+{
+    uint32_t cache[64] = {0};
+    uint32_t pixel = _start;
+#ifndef NDEBUG
+    const uint8_t* const end = in + inSize;
+#endif
+
+    for (eq_uint64_t i = 0; i < nPixels; ++i)
+    {
+        assert(in < end);
+        const uint8_t op = *in++;
+        if (op == _opRGB)
+        {
+            pixel = uint32_t(in[0]) | uint32_t(in[1]) << 8 |
+                    uint32_t(in[2]) << 16 | (pixel & 0xff000000u);
+            in += 3;
+        }
+        else if (op == _opRGBA)
+        {
+            pixel = uint32_t(in[0]) | uint32_t(in[1]) << 8 |
+                    uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24;
+            in += 4;
+        }
+        else
+            switch (op & _opMask)
+            {
+            case _opIndex:
+                pixel = cache[op];
+                out[i] = pixel;
+                continue;
+
+            case _opDiff:
+                pixel = _add(pixel, ((op >> 4) & 3) - 2, ((op >> 2) & 3) - 2,
+                             (op & 3) - 2);
+                break;
+
+            case _opLuma:
+            {
+                const int green = (op & 0x3f) - 32;
+                const uint8_t deltas = *in++;
+                pixel = _add(pixel, green + (deltas >> 4) - 8, green,
+                             green + (deltas & 0xf) - 8);
+                break;
+            }
+
+            default: // _opRun
+            {
+                const eq_uint64_t last =
+                    std::min(nPixels, i + (op & ~_opMask) + 1);
+                for (; i < last; ++i)
+                    out[i] = pixel;
+                --i;
+                continue;
+            }
+            }
+
+        cache[_hash(pixel)] = pixel;
+        out[i] = pixel;
+    }
+}
+}
+
+void CompressorQOI::compress(const void* const inData,
+                             const eq_uint64_t nPixels, const bool useAlpha)
+{
+    _nResults = _setupChunks(nPixels, _results);
+    const uint32_t* const in = reinterpret_cast<const uint32_t*>(inData);
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(_nResults); ++i)
+    {
+        const eq_uint64_t start = _getChunkStart(nPixels, _nResults, i);
+        const eq_uint64_t size = _getChunkStart(nPixels, _nResults, i + 1) -
+                                 start;
+        if (useAlpha)
+            _compressChunk<true>(in + start, size, *_results[i]);
+        else
+            _compressChunk<false>(in + start, size, *_results[i]);
+    }
+}
+
+void CompressorQOI::decompress(const void* const* inData,
+                               const eq_uint64_t* const inSizes,
+                               const unsigned nInputs, void* const outData,
+                               eq_uint64_t* const outDims,
+                               const eq_uint64_t flags, void* const)
+{
+    const eq_uint64_t nPixels =
+        (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
+    uint32_t* const out = reinterpret_cast<uint32_t*>(outData);
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nInputs); ++i)
+    {
+        const eq_uint64_t start = _getChunkStart(nPixels, nInputs, i);
+        _decompressChunk(reinterpret_cast<const uint8_t*>(inData[i]),
+                         inSizes[i], out + start,
+                         _getChunkStart(nPixels, nInputs, i + 1) - start);
+    }
+}
+}
+}
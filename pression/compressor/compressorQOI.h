@@ -0,0 +1,60 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef PRESSION_PLUGIN_COMPRESSORQOI
+#define PRESSION_PLUGIN_COMPRESSORQOI
+
+#include "compressor.h"
+
+namespace pression
+{
+namespace plugin
+{
+/**
+ * Single pass lossless compression of 32 bit pixels with 8 bit components, in
+ * the style of QOI.
+ *
+ * Each pixel is coded in one to five bytes as a run of the previous pixel, a
+ * reference into a cache of recent pixels indexed by a color hash, a small
+ * difference to the previous pixel, or verbatim. The pixels are split into
+ * chunks compressed in parallel, as by the RLE engines.
+ */
+class CompressorQOI : public Compressor
+{
+public:
+    CompressorQOI()
+        : Compressor()
+    {
+    }
+    virtual ~CompressorQOI() {}
+    void compress(const void* const inData, const eq_uint64_t nPixels,
+                  const bool useAlpha) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorQOI;
+    }
+};
+}
+}
+#endif // PRESSION_PLUGIN_COMPRESSORQOI
@@ -18,11 +18,20 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <pression/compressor/compressor.h>
 #ifdef PRESSION_USE_OPENMP
 #include <omp.h>
 #endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PRESSION_USE_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 namespace
 {
@@ -117,6 +126,263 @@ inline void _compressToken(const T in, T& last, T& numLast, T*& out)
 }
 #define COMPRESS(name) _compressToken(name, name##Last, name##Same, name##Out)
 
+// Writes a run of any length, split like _compressToken() does
+template <typename T>
+inline void _writeRun(const T token, uint64_t length, T*& out)
+{
+    const uint64_t maxLength = std::numeric_limits<T>::max();
+    for (; length > maxLength; length -= maxLength)
+        _write(token, T(maxLength), out);
+    _write(token, T(length), out);
+}
+
+#ifdef PRESSION_USE_SSE2
+// Planar compression of 32 bit pixels with 8 bit components: blocks of pixels
+// are swizzled and split into component planes, runs are detected on the
+// planes 16 components at a time. Produces the same output as _compress().
+const size_t _blockSize = 256; // pixels per block
+const size_t _vectorSize = 16; // bytes per SSE2 vector
+
+/**
+ * A vector of 32 or 64 bit pixels, for the bit and arithmetic operations of
+ * swizzleFunc::transform() and swizzleFunc::inverse().
+ */
+template <typename PixelType>
+class Pixels
+{
+public:
+    explicit Pixels(const __m128i value)
+        : v(value)
+    {
+    }
+    explicit Pixels(const PixelType value)
+        : v(sizeof(PixelType) == 4 ? _mm_set1_epi32(int(value))
+                                   : _mm_set1_epi64x(int64_t(value)))
+    {
+    }
+
+    Pixels operator|(const Pixels& rhs) const
+    {
+        return Pixels(_mm_or_si128(v, rhs.v));
+    }
+    Pixels operator&(const Pixels& rhs) const
+    {
+        return Pixels(_mm_and_si128(v, rhs.v));
+    }
+    Pixels operator<<(const unsigned n) const
+    {
+        const __m128i shift = _mm_cvtsi32_si128(int(n));
+        return Pixels(sizeof(PixelType) == 4 ? _mm_sll_epi32(v, shift)
+                                             : _mm_sll_epi64(v, shift));
+    }
+    Pixels operator>>(const unsigned n) const
+    {
+        const __m128i shift = _mm_cvtsi32_si128(int(n));
+        return Pixels(sizeof(PixelType) == 4 ? _mm_srl_epi32(v, shift)
+                                             : _mm_srl_epi64(v, shift));
+    }
+    Pixels operator+(const Pixels& rhs) const
+    {
+        return Pixels(sizeof(PixelType) == 4 ? _mm_add_epi32(v, rhs.v)
+                                             : _mm_add_epi64(v, rhs.v));
+    }
+    Pixels operator-(const Pixels& rhs) const
+    {
+        return Pixels(sizeof(PixelType) == 4 ? _mm_sub_epi32(v, rhs.v)
+                                             : _mm_sub_epi64(v, rhs.v));
+    }
+
+    __m128i v;
+};
+
+// Byte transpose of four vectors of four pixels into four component planes
+inline void _transpose(__m128i& one, __m128i& two, __m128i& three,
+                       __m128i& four)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const __m128i a = _mm_unpacklo_epi8(one, three);
+        const __m128i b = _mm_unpackhi_epi8(one, three);
+        const __m128i c = _mm_unpacklo_epi8(two, four);
+        const __m128i d = _mm_unpackhi_epi8(two, four);
+        one = a;
+        two = b;
+        three = c;
+        four = d;
+    }
+}
+
+inline unsigned _countTrailingZeros(const unsigned value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return unsigned(index);
+#else
+    return unsigned(__builtin_ctz(value));
+#endif
+}
+
+template <typename swizzleFunc>
+inline void _deinterleave(const uint32_t* const pixels, const size_t nPixels,
+                          uint8_t* const* planes)
+{
+    size_t i = 0;
+    for (; i + _vectorSize <= nPixels; i += _vectorSize)
+    {
+        __m128i v[4];
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const Pixels<uint32_t> input(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pixels + i + j * 4)));
+            v[j] = swizzleFunc::transform(input).v;
+        }
+        _transpose(v[0], v[1], v[2], v[3]);
+        for (size_t j = 0; j < 4; ++j)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[j] + i), v[j]);
+    }
+    for (; i < nPixels; ++i)
+    {
+        const uint32_t pixel = swizzleFunc::transform(pixels[i]);
+        planes[0][i] = pixel & 0xff;
+        planes[1][i] = (pixel >> 8) & 0xff;
+        planes[2][i] = (pixel >> 16) & 0xff;
+        planes[3][i] = pixel >> 24;
+    }
+}
+
+// @return bit i set if plane[i] differs from plane[i - 1], for 16 components
+inline unsigned _getChanges(const uint8_t* const plane)
+{
+    const __m128i current =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(plane));
+    const __m128i previous =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(plane - 1));
+    return ~unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(current, previous))) &
+           0xffffu;
+}
+
+inline __m128i _set1(const uint8_t value)
+{
+    return _mm_set1_epi8(char(value));
+}
+
+inline __m128i _set1(const uint16_t value)
+{
+    return _mm_set1_epi16(short(value));
+}
+
+// @return bit i set if byte i of the next 16 bytes belongs to an RLE marker
+inline unsigned _getMarkers(const uint8_t* const tokens)
+{
+    const __m128i current =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(tokens));
+    return unsigned(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(current, _set1(uint8_t(_rleMarker)))));
+}
+
+inline unsigned _getMarkers(const uint16_t* const tokens)
+{
+    const __m128i current =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(tokens));
+    return unsigned(_mm_movemask_epi8(
+        _mm_cmpeq_epi16(current, _set1(uint16_t(_rleMarker)))));
+}
+
+// Continues the run of last, plane[-1] has to be equal to last. The run
+// detection and the tokens are for 8 bit components only.
+inline void _compressPlane(const uint8_t* const plane, const size_t size,
+                           uint8_t& last, uint64_t& length, uint8_t*& out)
+{
+    size_t start = 0; // of the current run in this plane
+    for (size_t i = 0; i < size; i += _vectorSize)
+    {
+        unsigned changes = _getChanges(plane + i);
+        if (size - i < _vectorSize)
+            changes &= (1u << (size - i)) - 1;
+        else if (changes == 0xffffu && !_getMarkers(plane + i))
+        {
+            // no repetitions: close the current run, copy single tokens
+            _writeRun(last, length + i - start, out);
+            ::memcpy(out, plane + i, _vectorSize - 1);
+            out += _vectorSize - 1;
+            last = plane[i + _vectorSize - 1];
+            length = 0;
+            start = i + _vectorSize - 1;
+            continue;
+        }
+
+        while (changes)
+        {
+            const size_t j = i + _countTrailingZeros(changes);
+            changes &= changes - 1;
+
+            _writeRun(last, length + j - start, out);
+            last = plane[j];
+            length = 0;
+            start = j;
+        }
+    }
+    length += size - start;
+}
+
+template <typename swizzleFunc, typename alphaFunc>
+static inline void _compressPlanar(
+    const void* const input, const uint64_t nPixels,
+    pression::plugin::Compressor::Result** results)
+{
+    if (nPixels == 0)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            results[i]->setSize(0);
+        return;
+    }
+
+    const uint32_t* pixels = reinterpret_cast<const uint32_t*>(input);
+    const size_t nPlanes = alphaFunc::use() ? 4 : 3;
+
+    // planes with the previous component in front and room for vector reads
+    uint8_t buffers[4][1 + _blockSize + _vectorSize] = {};
+    uint8_t* planes[4];
+    uint8_t* out[4];
+    uint8_t last[4];
+    uint64_t lengths[4] = {0, 0, 0, 0};
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        planes[i] = buffers[i] + 1;
+        out[i] = results[i]->getData();
+    }
+    _deinterleave<swizzleFunc>(pixels, 1, planes);
+    for (size_t i = 0; i < 4; ++i)
+        last[i] = planes[i][0];
+
+    for (uint64_t i = 0; i < nPixels; i += _blockSize)
+    {
+        const size_t size = size_t(std::min(uint64_t(_blockSize), nPixels - i));
+        _deinterleave<swizzleFunc>(pixels + i, size, planes);
+        for (size_t j = 0; j < nPlanes; ++j)
+        {
+            buffers[j][0] = last[j];
+            _compressPlane(planes[j], size, last[j], lengths[j], out[j]);
+        }
+    }
+
+    for (size_t i = 0; i < nPlanes; ++i)
+        _writeRun(last[i], lengths[i], out[i]);
+    if (!alphaFunc::use()) // as _compress() does for the unused channel
+        _write(uint8_t(0), uint8_t(1), out[3]);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        results[i]->setSize(out[i] - results[i]->getData());
+#ifndef PRESSION_AGGRESSIVE_CACHING
+        results[i]->pack();
+#endif
+    }
+}
+#endif
+
 template <typename PixelType, typename ComponentType, typename swizzleFunc,
           typename alphaFunc>
 static inline void _compress(const void* const input, const uint64_t nPixels,
@@ -215,75 +481,216 @@ template <typename PixelType, typename ComponentType, typename swizzleFunc,
           typename alphaFunc>
 static inline void _decompress(const void* const* inData,
                                const eq_uint64_t* const inSizes LB_UNUSED,
-                               const unsigned nInputs, void* const outData,
-                               const eq_uint64_t nPixels)
+                               void* const outData, const uint64_t nPixels)
 {
-    assert((nInputs % 4) == 0);
     assert((inSizes[0] % sizeof(ComponentType)) == 0);
     assert((inSizes[1] % sizeof(ComponentType)) == 0);
     assert((inSizes[2] % sizeof(ComponentType)) == 0);
 
-    const uint64_t nElems = nPixels * 4;
-    const float width =
-        static_cast<float>(nElems) / static_cast<float>(nInputs);
-
     const ComponentType* const* in =
         reinterpret_cast<const ComponentType* const*>(inData);
+    PixelType* out = reinterpret_cast<PixelType*>(outData);
 
-#pragma omp parallel for
-    for (ssize_t i = 0; i < static_cast<ssize_t>(nInputs); i += 4)
+    const ComponentType* oneIn = in[0];
+    const ComponentType* twoIn = in[1];
+    const ComponentType* threeIn = in[2];
+    // cppcheck-suppress unreadVariable
+    const ComponentType* fourIn = in[3];
+
+    ComponentType one(0), two(0), three(0), four(0);
+    ComponentType oneLeft(0), twoLeft(0), threeLeft(0), fourLeft(0);
+
+    for (uint64_t j = 0; j < nPixels; ++j)
     {
-        const uint64_t startIndex = static_cast<uint64_t>(i / 4 * width) * 4;
-        const uint64_t nextIndex =
-            static_cast<uint64_t>((i / 4 + 1) * width) * 4;
-        const uint64_t chunkSize = (nextIndex - startIndex) / 4;
-        PixelType* out = reinterpret_cast<PixelType*>(outData) + startIndex / 4;
+        assert(static_cast<uint64_t>(oneIn - in[0]) <=
+               inSizes[0] / sizeof(ComponentType));
+        assert(static_cast<uint64_t>(twoIn - in[1]) <=
+               inSizes[1] / sizeof(ComponentType));
+        assert(static_cast<uint64_t>(threeIn - in[2]) <=
+               inSizes[2] / sizeof(ComponentType));
+
+        if (alphaFunc::use())
+        {
+            READ(one);
+            READ(two);
+            READ(three);
+            READ(four);
+
+            *out = swizzleFunc::deswizzle(one, two, three, four);
+        }
+        else
+        {
+            READ(one);
+            READ(two);
+            READ(three);
 
-        const ComponentType* oneIn = in[i + 0];
-        const ComponentType* twoIn = in[i + 1];
-        const ComponentType* threeIn = in[i + 2];
-        // cppcheck-suppress unreadVariable
-        const ComponentType* fourIn = in[i + 3];
+            *out = swizzleFunc::deswizzle(one, two, three);
+        }
+        ++out;
+    }
+    assert(static_cast<uint64_t>(oneIn - in[0]) ==
+           inSizes[0] / sizeof(ComponentType));
+    assert(static_cast<uint64_t>(twoIn - in[1]) ==
+           inSizes[1] / sizeof(ComponentType));
+    assert(static_cast<uint64_t>(threeIn - in[2]) ==
+           inSizes[2] / sizeof(ComponentType));
+}
 
-        ComponentType one(0), two(0), three(0), four(0);
-        ComponentType oneLeft(0), twoLeft(0), threeLeft(0), fourLeft(0);
+#ifdef PRESSION_USE_SSE2
+// Planar decompression: the runs of each component stream are expanded into
+// planes of _blockSize components, which are interleaved into pixels and
+// deswizzled 16 bytes at a time. Produces the same output as _decompress().
 
-        for (uint64_t j = 0; j < chunkSize; ++j)
+// Expands the next size components of a stream into plane, which has room
+// for 2 * _vectorSize bytes after size
+template <typename T>
+inline void _expandPlane(const T*& in, const T* const end, T& token,
+                         uint64_t& left, T* const plane, const size_t size)
+{
+    const size_t nComponents = _vectorSize / sizeof(T);
+    size_t i = 0;
+    while (i < size)
+    {
+        if (left == 0)
         {
-            assert(static_cast<uint64_t>(oneIn - in[i + 0]) <=
-                   inSizes[i + 0] / sizeof(ComponentType));
-            assert(static_cast<uint64_t>(twoIn - in[i + 1]) <=
-                   inSizes[i + 1] / sizeof(ComponentType));
-            assert(static_cast<uint64_t>(threeIn - in[i + 2]) <=
-                   inSizes[i + 2] / sizeof(ComponentType));
-
-            if (alphaFunc::use())
+            if (in + 2 * nComponents <= end)
             {
-                READ(one);
-                READ(two);
-                READ(three);
-                READ(four);
+                // copy the single tokens up to the next marker
+                const unsigned markers =
+                    _getMarkers(in) | (_getMarkers(in + nComponents) << 16);
+                const size_t nTokens =
+                    markers ? _countTrailingZeros(markers) / sizeof(T)
+                            : 2 * nComponents;
+                if (nTokens > 0)
+                {
+                    const size_t n = std::min(nTokens, size - i);
+                    ::memcpy(plane + i, in, 2 * _vectorSize);
+                    in += n;
+                    i += n;
+                    continue;
+                }
+            }
 
-                *out = swizzleFunc::deswizzle(one, two, three, four);
+            token = *in;
+            if (token == _rleMarker)
+            {
+                token = in[1];
+                left = in[2];
+                in += 3;
             }
             else
             {
-                READ(one);
-                READ(two);
-                READ(three);
-
-                *out = swizzleFunc::deswizzle(one, two, three);
+                left = 1;
+                ++in;
             }
-            ++out;
         }
-        assert(static_cast<uint64_t>(oneIn - in[i + 0]) ==
-               inSizes[i + 0] / sizeof(ComponentType));
-        assert(static_cast<uint64_t>(twoIn - in[i + 1]) ==
-               inSizes[i + 1] / sizeof(ComponentType));
-        assert(static_cast<uint64_t>(threeIn - in[i + 2]) ==
-               inSizes[i + 2] / sizeof(ComponentType));
+
+        const size_t n = size_t(std::min(left, uint64_t(size - i)));
+        const __m128i value = _set1(token);
+        for (size_t j = 0; j < n; j += nComponents)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(plane + i + j), value);
+        i += n;
+        left -= n;
+    }
+}
+
+// Interleave of four vectors of components into four vectors of pixels, the
+// inverse of _transpose()
+template <typename ComponentType>
+inline void _interleave(__m128i& one, __m128i& two, __m128i& three,
+                        __m128i& four)
+{
+    if (sizeof(ComponentType) == 1)
+    {
+        const __m128i a = _mm_unpacklo_epi8(one, two);
+        const __m128i b = _mm_unpackhi_epi8(one, two);
+        const __m128i c = _mm_unpacklo_epi8(three, four);
+        const __m128i d = _mm_unpackhi_epi8(three, four);
+        one = _mm_unpacklo_epi16(a, c);
+        two = _mm_unpackhi_epi16(a, c);
+        three = _mm_unpacklo_epi16(b, d);
+        four = _mm_unpackhi_epi16(b, d);
+    }
+    else
+    {
+        const __m128i a = _mm_unpacklo_epi16(one, two);
+        const __m128i b = _mm_unpackhi_epi16(one, two);
+        const __m128i c = _mm_unpacklo_epi16(three, four);
+        const __m128i d = _mm_unpackhi_epi16(three, four);
+        one = _mm_unpacklo_epi32(a, c);
+        two = _mm_unpackhi_epi32(a, c);
+        three = _mm_unpacklo_epi32(b, d);
+        four = _mm_unpackhi_epi32(b, d);
+    }
+}
+
+template <typename swizzleFunc, typename PixelType, typename ComponentType>
+inline void _interleave(
+    const ComponentType (*planes)[_blockSize + 2 * _vectorSize],
+                        const size_t nPixels, PixelType* const pixels)
+{
+    const size_t nComponents = _vectorSize / sizeof(ComponentType);
+    const size_t nVectorPixels = _vectorSize / sizeof(PixelType);
+    size_t i = 0;
+    for (; i + nComponents <= nPixels; i += nComponents)
+    {
+        __m128i v[4];
+        for (size_t j = 0; j < 4; ++j)
+            v[j] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(planes[j] + i));
+        _interleave<ComponentType>(v[0], v[1], v[2], v[3]);
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const Pixels<PixelType> output(v[j]);
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(pixels + i + j * nVectorPixels),
+                swizzleFunc::inverse(output).v);
+        }
+    }
+    for (; i < nPixels; ++i)
+    {
+        PixelType pixel = 0;
+        for (size_t j = 0; j < 4; ++j)
+            pixel |= PixelType(planes[j][i]) << (j * sizeof(ComponentType) * 8);
+        pixels[i] = swizzleFunc::inverse(pixel);
+    }
+}
+
+template <typename PixelType, typename ComponentType, typename swizzleFunc,
+          typename alphaFunc>
+static inline void _decompressPlanar(const void* const* inData,
+                                     const eq_uint64_t* const inSizes,
+                                     void* const outData,
+                                     const uint64_t nPixels)
+{
+    const size_t nPlanes = alphaFunc::use() ? 4 : 3;
+    PixelType* const pixels = reinterpret_cast<PixelType*>(outData);
+
+    // the unused alpha plane stays zero, as in _decompress()
+    ComponentType planes[4][_blockSize + 2 * _vectorSize] = {};
+    const ComponentType* in[4];
+    const ComponentType* end[4];
+    ComponentType tokens[4] = {0, 0, 0, 0};
+    uint64_t lefts[4] = {0, 0, 0, 0};
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        in[i] = reinterpret_cast<const ComponentType*>(inData[i]);
+        end[i] = in[i] + inSizes[i] / sizeof(ComponentType);
     }
+
+    for (uint64_t i = 0; i < nPixels; i += _blockSize)
+    {
+        const size_t size = size_t(std::min(uint64_t(_blockSize), nPixels - i));
+        for (size_t j = 0; j < nPlanes; ++j)
+            _expandPlane(in[j], end[j], tokens[j], lefts[j], planes[j], size);
+        _interleave<swizzleFunc>(planes, size, pixels + i);
+    }
+
+    for (size_t i = 0; i < 3; ++i)
+        assert(in[i] == end[i]);
 }
+#endif
 
 static unsigned _setupResults(
     const unsigned nChannels, const eq_uint64_t inSize,
@@ -314,21 +721,22 @@ static unsigned _setupResults(
     return nChunks;
 }
 
-template <typename PixelType, typename ComponentType, typename swizzleFunc,
-          typename alphaFunc>
-static inline unsigned _compress(
+typedef void (*CompressChunk_t)(const void* const, const uint64_t,
+                                pression::plugin::Compressor::Result**);
+
+static inline unsigned _compressChunks(
     const void* const inData, const eq_uint64_t nPixels,
+    const size_t pixelSize, const CompressChunk_t compressChunk,
     pression::plugin::Compressor::ResultVector& results)
 {
-    const uint64_t size = nPixels * sizeof(PixelType);
+    const uint64_t size = nPixels * pixelSize;
     const unsigned nChunks = _setupResults(4, size, results);
 
     const uint64_t nElems = nPixels * 4;
     const float width =
         static_cast<float>(nElems) / static_cast<float>(nChunks);
 
-    const ComponentType* const data =
-        reinterpret_cast<const ComponentType*>(inData);
+    const uint8_t* const data = reinterpret_cast<const uint8_t*>(inData);
 
 #pragma omp parallel for
     for (ssize_t i = 0; i < static_cast<ssize_t>(nChunks); i += 4)
@@ -338,10 +746,538 @@ static inline unsigned _compress(
             static_cast<uint64_t>((i / 4 + 1) * width) * 4;
         const uint64_t chunkSize = (nextIndex - startIndex) / 4;
 
-        _compress<PixelType, ComponentType, swizzleFunc, alphaFunc>(
-            &data[startIndex], chunkSize, &results[i]);
+        compressChunk(&data[startIndex / 4 * pixelSize], chunkSize,
+                      &results[i]);
     }
 
     return nChunks;
 }
+
+template <typename PixelType, typename ComponentType, typename swizzleFunc,
+          typename alphaFunc>
+static inline unsigned _compress(
+    const void* const inData, const eq_uint64_t nPixels,
+    pression::plugin::Compressor::ResultVector& results)
+{
+    return _compressChunks(
+        inData, nPixels, sizeof(PixelType),
+        _compress<PixelType, ComponentType, swizzleFunc, alphaFunc>, results);
+}
+
+/**
+ * Compress 32 bit pixels with 8 bit components using SSE2 if available, and
+ * _compress() otherwise. swizzleFunc has to implement the bit operations of
+ * swizzle() in transform() for uint32_t and Pixels.
+ */
+template <typename swizzleFunc, typename alphaFunc>
+static inline unsigned _compressPlanar(
+    const void* const inData, const eq_uint64_t nPixels,
+    pression::plugin::Compressor::ResultVector& results)
+{
+#ifdef PRESSION_USE_SSE2
+    return _compressChunks(inData, nPixels, sizeof(uint32_t),
+                           _compressPlanar<swizzleFunc, alphaFunc>, results);
+#else
+    return _compress<uint32_t, uint8_t, swizzleFunc, alphaFunc>(inData, nPixels,
+                                                                results);
+#endif
+}
+
+typedef void (*DecompressChunk_t)(const void* const*, const eq_uint64_t* const,
+                                  void* const, const uint64_t);
+
+static inline void _decompressChunks(const void* const* inData,
+                                     const eq_uint64_t* const inSizes,
+                                     const unsigned nInputs,
+                                     void* const outData,
+                                     const eq_uint64_t nPixels,
+                                     const size_t pixelSize,
+                                     const DecompressChunk_t decompressChunk)
+{
+    assert((nInputs % 4) == 0);
+
+    const uint64_t nElems = nPixels * 4;
+    const float width =
+        static_cast<float>(nElems) / static_cast<float>(nInputs);
+
+    uint8_t* const out = reinterpret_cast<uint8_t*>(outData);
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nInputs); i += 4)
+    {
+        const uint64_t startIndex = static_cast<uint64_t>(i / 4 * width) * 4;
+        const uint64_t nextIndex =
+            static_cast<uint64_t>((i / 4 + 1) * width) * 4;
+        const uint64_t chunkSize = (nextIndex - startIndex) / 4;
+
+        decompressChunk(&inData[i], &inSizes[i],
+                        &out[startIndex / 4 * pixelSize], chunkSize);
+    }
+}
+
+template <typename PixelType, typename ComponentType, typename swizzleFunc,
+          typename alphaFunc>
+static inline void _decompress(const void* const* inData,
+                               const eq_uint64_t* const inSizes,
+                               const unsigned nInputs, void* const outData,
+                               const eq_uint64_t nPixels)
+{
+    _decompressChunks(
+        inData, inSizes, nInputs, outData, nPixels, sizeof(PixelType),
+        _decompress<PixelType, ComponentType, swizzleFunc, alphaFunc>);
+}
+
+/**
+ * Decompress pixels using SSE2 if available, and _decompress() otherwise.
+ * swizzleFunc has to implement the bit operations of deswizzle() in inverse()
+ * for PixelType and Pixels.
+ */
+template <typename PixelType, typename ComponentType, typename swizzleFunc,
+          typename alphaFunc>
+static inline void _decompressPlanar(const void* const* inData,
+                                     const eq_uint64_t* const inSizes,
+                                     const unsigned nInputs,
+                                     void* const outData,
+                                     const eq_uint64_t nPixels)
+{
+#ifdef PRESSION_USE_SSE2
+    _decompressChunks(
+        inData, inSizes, nInputs, outData, nPixels, sizeof(PixelType),
+        _decompressPlanar<PixelType, ComponentType, swizzleFunc, alphaFunc>);
+#else
+    _decompress<PixelType, ComponentType, swizzleFunc, alphaFunc>(
+        inData, inSizes, nInputs, outData, nPixels);
+#endif
+}
+
+// Tiled compression: the image is split into tiles of _tileWidth x _tileHeight
+// pixels, which are compressed and decompressed independently. 1D data is split
+// into tiles of the same number of pixels. Wide tiles keep the rows written to
+// the output long, which is much faster than square tiles.
+const eq_uint64_t _tileWidth = 512;
+const eq_uint64_t _tileHeight = 32;
+
+/**
+ * The first result of a tiled compression, followed by the four results of
+ * each tile in row-major order. The tile position therefore indexes the results
+ * needed to decompress a region of interest.
+ */
+struct TileHeader
+{
+    eq_uint64_t dims[4];     //!< x, w, y, h of the compressed image
+    eq_uint64_t tileSize[2]; //!< width and height of a tile
+};
+
+// Sets the x, w, y, h dimensions of 1D or 2D data
+static inline void _getDims(const eq_uint64_t* const dims,
+                            const eq_uint64_t flags, eq_uint64_t result[4])
+{
+    const bool is1D = flags & EQ_COMPRESSOR_DATA_1D;
+    result[0] = dims[0];
+    result[1] = dims[1];
+    result[2] = is1D ? 0 : dims[2];
+    result[3] = is1D ? 1 : dims[3];
+}
+
+static inline TileHeader _getTileHeader(const eq_uint64_t* const dims,
+                                        const eq_uint64_t flags)
+{
+    TileHeader header;
+    _getDims(dims, flags, header.dims);
+    const bool is1D = flags & EQ_COMPRESSOR_DATA_1D;
+    header.tileSize[0] = is1D ? _tileWidth * _tileHeight : _tileWidth;
+    header.tileSize[1] = is1D ? 1 : _tileHeight;
+    return header;
+}
+
+static inline eq_uint64_t _getNumTiles(const eq_uint64_t size,
+                                       const eq_uint64_t tileSize)
+{
+    return (size + tileSize - 1) / tileSize;
+}
+
+static inline eq_uint64_t _getNumTilesX(const TileHeader& header)
+{
+    return _getNumTiles(header.dims[1], header.tileSize[0]);
+}
+
+static inline eq_uint64_t _getNumTiles(const TileHeader& header)
+{
+    return _getNumTilesX(header) *
+           _getNumTiles(header.dims[3], header.tileSize[1]);
+}
+
+// Sets the x, w, y, h of the tile at index, relative to the image
+static inline void _getTile(const TileHeader& header, const eq_uint64_t index,
+                            eq_uint64_t tile[4])
+{
+    const eq_uint64_t nTilesX = _getNumTilesX(header);
+    tile[0] = index % nTilesX * header.tileSize[0];
+    tile[1] = std::min(header.tileSize[0], header.dims[1] - tile[0]);
+    tile[2] = index / nTilesX * header.tileSize[1];
+    tile[3] = std::min(header.tileSize[1], header.dims[3] - tile[2]);
+}
+
+// @return the number of results for the header and nTiles tiles
+static inline unsigned _setupTileResults(
+    const eq_uint64_t nTiles,
+    pression::plugin::Compressor::ResultVector& results)
+{
+    const unsigned nResults = unsigned(1 + nTiles * 4);
+    while (results.size() < nResults)
+        results.push_back(new pression::plugin::Compressor::Result);
+    return nResults;
+}
+
+// Compresses the tile at index into four results, tile is scratch space
+static inline void _compressTile(const uint8_t* const data,
+                                 const TileHeader& header,
+                                 const eq_uint64_t index,
+                                 const size_t pixelSize,
+                                 const CompressChunk_t compressChunk,
+                                 pression::plugin::Compressor::Result** results,
+                                 std::vector<uint8_t>& tile)
+{
+    eq_uint64_t dims[4];
+    _getTile(header, index, dims);
+    const eq_uint64_t width = header.dims[1];
+    const eq_uint64_t nPixels = dims[1] * dims[3];
+    const size_t rowSize = dims[1] * pixelSize;
+    const uint8_t* const start = &data[(dims[2] * width + dims[0]) * pixelSize];
+
+    // same worst case as in _setupResults()
+    for (size_t i = 0; i < 4; ++i)
+        results[i]->reserve((nPixels * pixelSize / 4 + 1) * 2);
+
+    if (dims[1] == width) // rows of the tile are contiguous
+    {
+        compressChunk(start, nPixels, results);
+        return;
+    }
+
+    tile.resize(nPixels * pixelSize);
+    for (eq_uint64_t i = 0; i < dims[3]; ++i)
+        ::memcpy(&tile[i * rowSize], start + i * width * pixelSize, rowSize);
+    compressChunk(tile.data(), nPixels, results);
+}
+
+// Decompresses the tile at index from four inputs into the region (x, w, y, h)
+// of the image at out, tile is scratch space
+static inline void _decompressTile(const void* const* inData,
+                                   const eq_uint64_t* const inSizes,
+                                   const TileHeader& header,
+                                   const eq_uint64_t index,
+                                   const eq_uint64_t* const region,
+                                   uint8_t* const out, const size_t pixelSize,
+                                   const DecompressChunk_t decompressChunk,
+                                   std::vector<uint8_t>& tile)
+{
+    eq_uint64_t dims[4];
+    _getTile(header, index, dims);
+    const eq_uint64_t nPixels = dims[1] * dims[3];
+
+    // intersection of the tile with the region
+    const eq_uint64_t startX = std::max(dims[0], region[0]);
+    const eq_uint64_t startY = std::max(dims[2], region[2]);
+    const eq_uint64_t endX = std::min(dims[0] + dims[1], region[0] + region[1]);
+    const eq_uint64_t endY = std::min(dims[2] + dims[3], region[2] + region[3]);
+    uint8_t* const start =
+        &out[((startY - region[2]) * region[1] + startX - region[0]) *
+             pixelSize];
+
+    if (dims[0] == region[0] && dims[1] == region[1] && startY == dims[2] &&
+        endY == dims[2] + dims[3])
+    {
+        // the whole tile covers complete rows of the output
+        decompressChunk(inData, inSizes, start, nPixels);
+        return;
+    }
+
+    tile.resize(nPixels * pixelSize);
+    decompressChunk(inData, inSizes, tile.data(), nPixels);
+    const size_t rowSize = (endX - startX) * pixelSize;
+    for (eq_uint64_t i = startY; i < endY; ++i)
+        ::memcpy(start + (i - startY) * region[1] * pixelSize,
+                 &tile[((i - dims[2]) * dims[1] + startX - dims[0]) *
+                       pixelSize],
+                 rowSize);
+}
+
+static inline unsigned _compressTiles(
+    const void* const inData, const eq_uint64_t* const inDims,
+    const eq_uint64_t flags, const size_t pixelSize,
+    const CompressChunk_t compressChunk,
+    pression::plugin::Compressor::ResultVector& results)
+{
+    const TileHeader header = _getTileHeader(inDims, flags);
+    const eq_uint64_t nTiles = _getNumTiles(header);
+    const unsigned nResults = _setupTileResults(nTiles, results);
+    results[0]->replace(&header, sizeof(header));
+
+    LBVERB << "Compressing " << header.dims[1] << "x" << header.dims[3]
+           << " pixels in " << nTiles << " tiles" << std::endl;
+
+    const uint8_t* const data = reinterpret_cast<const uint8_t*>(inData);
+
+#pragma omp parallel
+    {
+        std::vector<uint8_t> tile;
+
+#pragma omp for
+        for (ssize_t i = 0; i < static_cast<ssize_t>(nTiles); ++i)
+            _compressTile(data, header, i, pixelSize, compressChunk,
+                          &results[1 + i * 4], tile);
+    }
+    return nResults;
+}
+
+/**
+ * Decompress the tiles intersecting the region of interest given by outDims,
+ * which has to lie within the compressed image.
+ */
+static inline void _decompressTiles(const void* const* inData,
+                                    const eq_uint64_t* const inSizes,
+                                    const unsigned nInputs LB_UNUSED,
+                                    void* const outData,
+                                    const eq_uint64_t* const outDims,
+                                    const eq_uint64_t flags,
+                                    const size_t pixelSize,
+                                    const DecompressChunk_t decompressChunk)
+{
+    assert(nInputs > 0 && inSizes[0] == sizeof(TileHeader));
+    TileHeader header;
+    ::memcpy(&header, inData[0], sizeof(header));
+    assert(nInputs == 1 + _getNumTiles(header) * 4);
+
+    // region of interest relative to the compressed image
+    eq_uint64_t region[4];
+    _getDims(outDims, flags, region);
+    assert(region[0] >= header.dims[0] && region[2] >= header.dims[2]);
+    region[0] -= header.dims[0];
+    region[2] -= header.dims[2];
+    assert(region[0] + region[1] <= header.dims[1]);
+    assert(region[2] + region[3] <= header.dims[3]);
+    if (region[1] == 0 || region[3] == 0)
+        return;
+
+    const eq_uint64_t tileWidth = header.tileSize[0];
+    const eq_uint64_t tileHeight = header.tileSize[1];
+    const eq_uint64_t nTilesX = _getNumTilesX(header);
+    const eq_uint64_t firstX = region[0] / tileWidth;
+    const eq_uint64_t firstY = region[2] / tileHeight;
+    const eq_uint64_t nX = (region[0] + region[1] - 1) / tileWidth - firstX + 1;
+    const eq_uint64_t nY =
+        (region[2] + region[3] - 1) / tileHeight - firstY + 1;
+
+    uint8_t* const out = reinterpret_cast<uint8_t*>(outData);
+
+#pragma omp parallel
+    {
+        std::vector<uint8_t> tile;
+
+#pragma omp for
+        for (ssize_t i = 0; i < static_cast<ssize_t>(nX * nY); ++i)
+        {
+            const eq_uint64_t index =
+                (firstY + i / nX) * nTilesX + firstX + i % nX;
+            _decompressTile(&inData[1 + index * 4], &inSizes[1 + index * 4],
+                            header, index, region, out, pixelSize,
+                            decompressChunk, tile);
+        }
+    }
+}
+
+/**
+ * The first result of a dirty tile compression. It is followed by a bitmap of
+ * the compressed tiles in the same result, and by the four results of each
+ * compressed tile. The reference of a keyframe is the frame itself, and all of
+ * its tiles are compressed.
+ */
+struct DirtyTileHeader
+{
+    TileHeader tiles;
+    eq_uint64_t frame;     //!< the number of the compressed frame
+    eq_uint64_t reference; //!< the number of the frame patched by the tiles
+};
+
+// @return true if the tile at index differs between data and reference, after
+//         copying it to reference
+static inline bool _updateTile(const uint8_t* const data,
+                               uint8_t* const reference,
+                               const TileHeader& header,
+                               const eq_uint64_t index, const size_t pixelSize)
+{
+    eq_uint64_t dims[4];
+    _getTile(header, index, dims);
+    const size_t rowSize = dims[1] * pixelSize;
+    const size_t stride = header.dims[1] * pixelSize;
+    const size_t start = (dims[2] * header.dims[1] + dims[0]) * pixelSize;
+
+    eq_uint64_t i = 0;
+    while (i < dims[3] && ::memcmp(data + start + i * stride,
+                                   reference + start + i * stride,
+                                   rowSize) == 0)
+    {
+        ++i;
+    }
+    if (i == dims[3])
+        return false;
+
+    for (; i < dims[3]; ++i)
+        ::memcpy(reference + start + i * stride, data + start + i * stride,
+                 rowSize);
+    return true;
+}
+
+/**
+ * Compress the tiles of data which differ from the reference image, and copy
+ * them to the reference. Compresses all tiles of a keyframe, whose reference
+ * has to be a copy of data already.
+ */
+static inline unsigned _compressDirtyTiles(
+    const void* const inData, uint8_t* const reference,
+    const DirtyTileHeader& header, const size_t pixelSize,
+    const CompressChunk_t compressChunk,
+    pression::plugin::Compressor::ResultVector& results)
+{
+    const bool keyFrame = header.frame == header.reference;
+    const eq_uint64_t nTiles = _getNumTiles(header.tiles);
+    _setupTileResults(nTiles, results);
+    const uint8_t* const data = reinterpret_cast<const uint8_t*>(inData);
+    std::vector<uint8_t> dirty(nTiles, keyFrame);
+
+#pragma omp parallel
+    {
+        std::vector<uint8_t> tile;
+
+#pragma omp for
+        for (ssize_t i = 0; i < static_cast<ssize_t>(nTiles); ++i)
+        {
+            if (!keyFrame &&
+                !_updateTile(data, reference, header.tiles, i, pixelSize))
+            {
+                continue;
+            }
+            dirty[i] = true;
+            _compressTile(data, header.tiles, i, pixelSize, compressChunk,
+                          &results[1 + i * 4], tile);
+        }
+    }
+
+    // move the results of the dirty tiles to the front, after the header
+    std::vector<uint8_t> bitmap((nTiles + 7) / 8, 0);
+    eq_uint64_t nDirty = 0;
+    for (eq_uint64_t i = 0; i < nTiles; ++i)
+    {
+        if (!dirty[i])
+            continue;
+        bitmap[i / 8] |= uint8_t(1u << (i % 8));
+        for (size_t j = 1; j <= 4; ++j)
+            std::swap(results[nDirty * 4 + j], results[i * 4 + j]);
+        ++nDirty;
+    }
+
+    results[0]->replace(&header, sizeof(header));
+    results[0]->append(bitmap.data(), bitmap.size());
+
+    LBVERB << "Compressed " << nDirty << " of " << nTiles << " tiles"
+           << std::endl;
+    return unsigned(1 + nDirty * 4);
+}
+
+/** Decompress the dirty tiles into the reference image. */
+static inline void _decompressDirtyTiles(const void* const* inData,
+                                         const eq_uint64_t* const inSizes,
+                                         const unsigned nInputs LB_UNUSED,
+                                         uint8_t* const reference,
+                                         const size_t pixelSize,
+                                         const DecompressChunk_t
+                                             decompressChunk)
+{
+    DirtyTileHeader header;
+    ::memcpy(&header, inData[0], sizeof(header));
+    const eq_uint64_t nTiles = _getNumTiles(header.tiles);
+    assert(inSizes[0] == sizeof(header) + (nTiles + 7) / 8);
+
+    const uint8_t* const bitmap =
+        reinterpret_cast<const uint8_t*>(inData[0]) + sizeof(header);
+    std::vector<eq_uint64_t> tiles;
+    for (eq_uint64_t i = 0; i < nTiles; ++i)
+        if (bitmap[i / 8] & (1u << (i % 8)))
+            tiles.push_back(i);
+    assert(nInputs == 1 + tiles.size() * 4);
+
+    const eq_uint64_t region[4] = {0, header.tiles.dims[1], 0,
+                                   header.tiles.dims[3]};
+
+#pragma omp parallel
+    {
+        std::vector<uint8_t> tile;
+
+#pragma omp for
+        for (ssize_t i = 0; i < static_cast<ssize_t>(tiles.size()); ++i)
+            _decompressTile(&inData[1 + i * 4], &inSizes[1 + i * 4],
+                            header.tiles, tiles[i], region, reference,
+                            pixelSize, decompressChunk, tile);
+    }
+}
+
+/**
+ * @return the function compressing a chunk of 32 bit pixels with 8 bit
+ *         components, using SSE2 if available. See _compressPlanar() for the
+ *         requirements on swizzleFunc.
+ */
+template <typename swizzleFunc, typename alphaFunc>
+static inline CompressChunk_t _getCompressChunk()
+{
+#ifdef PRESSION_USE_SSE2
+    return _compressPlanar<swizzleFunc, alphaFunc>;
+#else
+    return _compress<uint32_t, uint8_t, swizzleFunc, alphaFunc>;
+#endif
+}
+
+/**
+ * @return the function decompressing a chunk of pixels, using SSE2 if
+ *         available. See _decompressPlanar() for the requirements on
+ *         swizzleFunc.
+ */
+template <typename PixelType, typename ComponentType, typename swizzleFunc,
+          typename alphaFunc>
+static inline DecompressChunk_t _getDecompressChunk()
+{
+#ifdef PRESSION_USE_SSE2
+    return _decompressPlanar<PixelType, ComponentType, swizzleFunc, alphaFunc>;
+#else
+    return _decompress<PixelType, ComponentType, swizzleFunc, alphaFunc>;
+#endif
+}
+
+/** Compress 32 bit pixels with 8 bit components in tiles. */
+template <typename swizzleFunc, typename alphaFunc>
+static inline unsigned _compressTiles(
+    const void* const inData, const eq_uint64_t* const inDims,
+    const eq_uint64_t flags,
+    pression::plugin::Compressor::ResultVector& results)
+{
+    return _compressTiles(inData, inDims, flags, sizeof(uint32_t),
+                          _getCompressChunk<swizzleFunc, alphaFunc>(),
+                          results);
+}
+
+/** Decompress the tiles of the region of interest given by outDims. */
+template <typename PixelType, typename ComponentType, typename swizzleFunc,
+          typename alphaFunc>
+static inline void _decompressTiles(const void* const* inData,
+                                    const eq_uint64_t* const inSizes,
+                                    const unsigned nInputs,
+                                    void* const outData,
+                                    const eq_uint64_t* const outDims,
+                                    const eq_uint64_t flags)
+{
+    _decompressTiles(
+        inData, inSizes, nInputs, outData, outDims, flags, sizeof(PixelType),
+        _getDecompressChunk<PixelType, ComponentType, swizzleFunc,
+                            alphaFunc>());
+}
 }
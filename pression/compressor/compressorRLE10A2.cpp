@@ -36,6 +36,17 @@ REGISTER_ENGINE(CompressorRLE10A2, DIFF_BGR10_A2, BGR10_A2, 1., 0.57, 1., true);
 class SwizzleUInt32
 {
 public:
+    /** Bit operations of deswizzle(), for one uint32_t or for Pixels. */
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return (input & T(0xf000000fu)) | ((input & T(0x30u)) << 8) |
+               ((input & T(0x3c0u)) << 16) | ((input & T(0x30c00u)) << 4) |
+               ((input & T(0x300000u)) << 6) | ((input & T(0xc0000u)) >> 2) |
+               ((input & T(0xc000u)) >> 4) | ((input & T(0xc003000u)) >> 8) |
+               ((input & T(0x3c00000u)) >> 16);
+    }
+
     static inline void swizzle(const uint32_t input, uint8_t& one, uint8_t& two,
                                uint8_t& three, uint8_t& four)
     {
@@ -65,16 +76,9 @@ public:
     static inline uint32_t deswizzle(const uint8_t one, const uint8_t two,
                                      const uint8_t three, const uint8_t four)
     {
-        return (one & 0xf) | ((one & (LB_BIT5 | LB_BIT6)) << 8) |
-               ((one & (LB_BIT7 | LB_BIT8)) << 16) |
-               ((two & (LB_BIT1 | LB_BIT2)) << 24) |
-               ((two & (LB_BIT3 | LB_BIT4)) << 12) | (two & 0x30) |
-               ((two & (LB_BIT7 | LB_BIT8)) << 4) | (three & 0xc0) |
-               ((three & (LB_BIT6 | LB_BIT5)) << 22) |
-               ((three & (LB_BIT4 | LB_BIT3)) << 14) |
-               ((three & (LB_BIT2 | LB_BIT1)) << 20) | ((four & 0xf0) << 24) |
-               ((four & (LB_BIT4 | LB_BIT3)) << 16) |
-               ((four & (LB_BIT2 | LB_BIT1)) << 8);
+        const uint32_t input =
+            one + (two << 8) + (three << 16) + (uint32_t(four) << 24);
+        return inverse(input);
     }
 
     static inline uint32_t deswizzle(const uint8_t, const uint8_t,
@@ -104,9 +108,8 @@ void CompressorRLE10A2::decompress(const void* const* inData,
 {
     const eq_uint64_t nPixels =
         (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
-    _decompress<uint32_t, uint8_t, SwizzleUInt32, UseAlpha>(inData, inSizes,
-                                                            numInputs, outData,
-                                                            nPixels);
+    _decompressPlanar<uint32_t, uint8_t, SwizzleUInt32, UseAlpha>(
+        inData, inSizes, numInputs, outData, nPixels);
 }
 }
 }
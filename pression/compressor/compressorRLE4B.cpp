@@ -49,9 +49,91 @@ REGISTER_ENGINE(CompressorDiffRLE4B, DIFF_RGBA_UINT_8_8_8_8_REV,
 REGISTER_ENGINE(CompressorDiffRLE4B, DIFF_BGRA_UINT_8_8_8_8_REV,
                 BGRA_UINT_8_8_8_8_REV, 1., .5, 1.1, true);
 
+REGISTER_ENGINE(CompressorYCoCgRLE4B, YCOCG_RGBA, RGBA, 1., .46, 1., true);
+REGISTER_ENGINE(CompressorYCoCgRLE4B, YCOCG_BGRA, BGRA, 1., .46, 1., true);
+
+REGISTER_ENGINE(CompressorRLETile4B, TILE_RGBA, RGBA, 1., 0.6, .95, true);
+REGISTER_ENGINE(CompressorRLETile4B, TILE_BGRA, BGRA, 1., 0.6, .95, true);
+REGISTER_ENGINE(CompressorDiffRLETile4B, TILE_DIFF_RGBA, RGBA, 1., .51, 1.05,
+                true);
+REGISTER_ENGINE(CompressorDiffRLETile4B, TILE_DIFF_BGRA, BGRA, 1., .51, 1.05,
+                true);
+
+REGISTER_ENGINE(CompressorRLEDelta4B, DELTA_RGBA, RGBA, 1., .59, .95, true);
+REGISTER_ENGINE(CompressorRLEDelta4B, DELTA_BGRA, BGRA, 1., .59, .95, true);
+
+REGISTER_ENGINE(CompressorRLEDirty4B, DIRTY_RGBA, RGBA, 1., .59, .95, true);
+REGISTER_ENGINE(CompressorRLEDirty4B, DIRTY_BGRA, BGRA, 1., .59, .95, true);
+
+const eq_uint64_t _keyFrameInterval = 60; // frames
+
+/**
+ * The last result of a delta compression. The reference of a keyframe is the
+ * frame itself.
+ */
+struct DeltaHeader
+{
+    eq_uint64_t frame;     //!< the number of the compressed frame
+    eq_uint64_t reference; //!< the number of the frame the delta applies to
+};
+
+// residual = input ^ reference, reference = input
+void _delta(const uint8_t* const input, uint8_t* const reference,
+            uint8_t* const residual, const uint64_t size)
+{
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t in, ref;
+        ::memcpy(&in, input + i, sizeof(in));
+        ::memcpy(&ref, reference + i, sizeof(ref));
+        ref ^= in;
+        ::memcpy(residual + i, &ref, sizeof(ref));
+        ::memcpy(reference + i, &in, sizeof(in));
+    }
+    for (; i < size; ++i)
+    {
+        residual[i] = input[i] ^ reference[i];
+        reference[i] = input[i];
+    }
+}
+
+// data ^= reference, reference = data
+void _undelta(uint8_t* const data, uint8_t* const reference,
+              const uint64_t size)
+{
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t value, ref;
+        ::memcpy(&value, data + i, sizeof(value));
+        ::memcpy(&ref, reference + i, sizeof(ref));
+        value ^= ref;
+        ::memcpy(data + i, &value, sizeof(value));
+        ::memcpy(reference + i, &value, sizeof(value));
+    }
+    for (; i < size; ++i)
+    {
+        data[i] ^= reference[i];
+        reference[i] = data[i];
+    }
+}
+
 class NoSwizzle
 {
 public:
+    template <typename T>
+    static inline T transform(const T& input)
+    {
+        return input;
+    }
+
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return input;
+    }
+
     static inline void swizzle(const uint32_t input, uint8_t& one, uint8_t& two,
                                uint8_t& three, uint8_t& four)
     {
@@ -85,23 +167,46 @@ public:
 class SwizzleUInt32
 {
 public:
+    /** Bit operations of swizzle(), for one uint32_t or for Pixels. */
+    template <typename T>
+    static inline T transform(const T& input)
+    {
+        return (input & T(LB_BIT32 | LB_BIT31 | LB_BIT22 | LB_BIT21 |
+                          LB_BIT12 | LB_BIT11 | LB_BIT2 | LB_BIT1)) |
+               ((input & T(LB_BIT8 | LB_BIT7)) << 18) |
+               ((input & T(LB_BIT24 | LB_BIT23 | LB_BIT14 | LB_BIT13)) << 6) |
+               ((input & T(LB_BIT16 | LB_BIT15 | LB_BIT6 | LB_BIT5 | LB_BIT4 |
+                           LB_BIT3))
+                << 12) |
+               ((input & T(LB_BIT28 | LB_BIT27 | LB_BIT26 | LB_BIT25)) >> 18) |
+               ((input & T(LB_BIT18 | LB_BIT17)) >> 12) |
+               ((input & T(LB_BIT30 | LB_BIT29 | LB_BIT20 | LB_BIT19 |
+                           LB_BIT10 | LB_BIT9)) >>
+                6);
+    }
+
+    /** Bit operations of deswizzle(), for one uint32_t or for Pixels. */
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return (input & T(LB_BIT32 | LB_BIT31 | LB_BIT22 | LB_BIT21 |
+                          LB_BIT11 | LB_BIT12 | LB_BIT2 | LB_BIT1)) |
+               ((input & T(LB_BIT26 | LB_BIT25)) >> 18) |
+               ((input & T(LB_BIT30 | LB_BIT29 | LB_BIT20 | LB_BIT19)) >> 6) |
+               ((input & T(LB_BIT28 | LB_BIT27 | LB_BIT18 | LB_BIT17 |
+                           LB_BIT16 | LB_BIT15)) >>
+                12) |
+               ((input & T(LB_BIT10 | LB_BIT9 | LB_BIT8 | LB_BIT7)) << 18) |
+               ((input & T(LB_BIT6 | LB_BIT5)) << 12) |
+               ((input & T(LB_BIT24 | LB_BIT23 | LB_BIT14 | LB_BIT13 |
+                           LB_BIT4 | LB_BIT3))
+                << 6);
+    }
+
     static inline void swizzle(const uint32_t input, uint8_t& one, uint8_t& two,
                                uint8_t& three, uint8_t& four)
     {
-        NoSwizzle::swizzle(
-            ((input & (LB_BIT32 | LB_BIT31 | LB_BIT22 | LB_BIT21 | LB_BIT12 |
-                       LB_BIT11 | LB_BIT2 | LB_BIT1)) |
-             ((input & (LB_BIT8 | LB_BIT7)) << 18) |
-             ((input & (LB_BIT24 | LB_BIT23 | LB_BIT14 | LB_BIT13)) << 6) |
-             ((input &
-               (LB_BIT16 | LB_BIT15 | LB_BIT6 | LB_BIT5 | LB_BIT4 | LB_BIT3))
-              << 12) |
-             ((input & (LB_BIT28 | LB_BIT27 | LB_BIT26 | LB_BIT25)) >> 18) |
-             ((input & (LB_BIT18 | LB_BIT17)) >> 12) |
-             ((input & (LB_BIT30 | LB_BIT29 | LB_BIT20 | LB_BIT19 | LB_BIT10 |
-                        LB_BIT9)) >>
-              6)),
-            one, two, three, four);
+        NoSwizzle::swizzle(transform(input), one, two, three, four);
     }
     static inline void swizzle(const uint32_t, uint8_t&, uint8_t&, uint8_t&)
     {
@@ -111,19 +216,7 @@ public:
     static inline uint32_t deswizzle(const uint8_t one, const uint8_t two,
                                      const uint8_t three, const uint8_t four)
     {
-        const uint32_t input = one + (two << 8) + (three << 16) + (four << 24);
-        return ((input & (LB_BIT32 | LB_BIT31 | LB_BIT22 | LB_BIT21 | LB_BIT11 |
-                          LB_BIT12 | LB_BIT2 | LB_BIT1)) |
-                ((input & (LB_BIT26 | LB_BIT25)) >> 18) |
-                ((input & (LB_BIT30 | LB_BIT29 | LB_BIT20 | LB_BIT19)) >> 6) |
-                ((input & (LB_BIT28 | LB_BIT27 | LB_BIT18 | LB_BIT17 |
-                           LB_BIT16 | LB_BIT15)) >>
-                 12) |
-                ((input & (LB_BIT10 | LB_BIT9 | LB_BIT8 | LB_BIT7)) << 18) |
-                ((input & (LB_BIT6 | LB_BIT5)) << 12) |
-                ((input & (LB_BIT24 | LB_BIT23 | LB_BIT14 | LB_BIT13 | LB_BIT4 |
-                           LB_BIT3))
-                 << 6));
+        return inverse(NoSwizzle::deswizzle(one, two, three, four));
     }
 
     static inline uint32_t deswizzle(const uint8_t, const uint8_t,
@@ -137,6 +230,36 @@ public:
 class SwizzleUInt24
 {
 public:
+    /** Bit operations of swizzle(), for one uint32_t or for Pixels. */
+    template <typename T>
+    static inline T transform(const T& input)
+    {
+        return (input & T(LB_BIT24 | LB_BIT23 | LB_BIT22 | LB_BIT13 |
+                          LB_BIT12 | LB_BIT3 | LB_BIT2 | LB_BIT1)) |
+               ((input & T(LB_BIT16 | LB_BIT15 | LB_BIT14)) << 5) |
+               ((input & T(LB_BIT11 | LB_BIT10 | LB_BIT9)) >> 5) |
+               ((input & T(LB_BIT8 | LB_BIT7 | LB_BIT6 | LB_BIT5 | LB_BIT4))
+                << 10) |
+               ((input & T(LB_BIT21 | LB_BIT20 | LB_BIT19 | LB_BIT18 |
+                           LB_BIT17)) >>
+                10);
+    }
+
+    /** Bit operations of deswizzle(), for one uint32_t or for Pixels. */
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return (input & T(LB_BIT24 | LB_BIT23 | LB_BIT22 | LB_BIT13 |
+                          LB_BIT12 | LB_BIT3 | LB_BIT2 | LB_BIT1)) |
+               ((input & T(LB_BIT21 | LB_BIT20 | LB_BIT19)) >> 5) |
+               ((input & T(LB_BIT6 | LB_BIT5 | LB_BIT4)) << 5) |
+               ((input & T(LB_BIT18 | LB_BIT17 | LB_BIT16 | LB_BIT15 |
+                           LB_BIT14)) >>
+                10) |
+               ((input & T(LB_BIT11 | LB_BIT10 | LB_BIT9 | LB_BIT8 | LB_BIT7))
+                << 10);
+    }
+
     static inline void swizzle(const uint32_t, uint8_t&, uint8_t&, uint8_t&,
                                uint8_t&)
     {
@@ -146,17 +269,7 @@ public:
     static inline void swizzle(const uint32_t input, uint8_t& one, uint8_t& two,
                                uint8_t& three)
     {
-        NoSwizzle::swizzle(
-            ((input & (LB_BIT24 | LB_BIT23 | LB_BIT22 | LB_BIT13 | LB_BIT12 |
-                       LB_BIT3 | LB_BIT2 | LB_BIT1)) |
-             ((input & (LB_BIT16 | LB_BIT15 | LB_BIT14)) << 5) |
-             ((input & (LB_BIT11 | LB_BIT10 | LB_BIT9)) >> 5) |
-             ((input & (LB_BIT8 | LB_BIT7 | LB_BIT6 | LB_BIT5 | LB_BIT4))
-              << 10) |
-             ((input &
-               (LB_BIT21 | LB_BIT20 | LB_BIT19 | LB_BIT18 | LB_BIT17)) >>
-              10)),
-            one, two, three);
+        NoSwizzle::swizzle(transform(input), one, two, three);
     }
     static inline uint32_t deswizzle(const uint8_t, const uint8_t,
                                      const uint8_t, const uint8_t)
@@ -168,16 +281,80 @@ public:
     static inline uint32_t deswizzle(const uint8_t one, const uint8_t two,
                                      const uint8_t three)
     {
-        const uint32_t input = one + (two << 8) + (three << 16);
-        return (
-            (input & (LB_BIT24 | LB_BIT23 | LB_BIT22 | LB_BIT13 | LB_BIT12 |
-                      LB_BIT3 | LB_BIT2 | LB_BIT1)) |
-            ((input & (LB_BIT21 | LB_BIT20 | LB_BIT19)) >> 5) |
-            ((input & (LB_BIT6 | LB_BIT5 | LB_BIT4)) << 5) |
-            ((input & (LB_BIT18 | LB_BIT17 | LB_BIT16 | LB_BIT15 | LB_BIT14)) >>
-             10) |
-            ((input & (LB_BIT11 | LB_BIT10 | LB_BIT9 | LB_BIT8 | LB_BIT7))
-             << 10));
+        return inverse(NoSwizzle::deswizzle(one, two, three));
+    }
+};
+
+/**
+ * The reversible YCoCg-R color transform, computed modulo 256 so that all
+ * components stay 8 bit, followed by the bit swizzle of bitSwizzleFunc. Y, Co
+ * and Cg replace red, green and blue, and alpha is kept.
+ */
+template <class bitSwizzleFunc>
+class SwizzleYCoCg
+{
+public:
+    /** Operations of swizzle(), for one uint32_t or for Pixels. */
+    template <typename T>
+    static inline T transform(const T& input)
+    {
+        const T mask(0xffu);
+        const T red = input & mask;
+        const T green = (input >> 8) & mask;
+        const T blue = (input >> 16) & mask;
+        const T co = (red - blue) & mask;
+        const T temp = (blue + _halve(co)) & mask;
+        const T cg = (green - temp) & mask;
+        const T y = (temp + _halve(cg)) & mask;
+        return bitSwizzleFunc::transform(y | (co << 8) | (cg << 16) |
+                                         (input & T(0xff000000u)));
+    }
+
+    /** Operations of deswizzle(), for one uint32_t or for Pixels. */
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        const T mask(0xffu);
+        const T ycocg = bitSwizzleFunc::inverse(input);
+        const T co = (ycocg >> 8) & mask;
+        const T cg = (ycocg >> 16) & mask;
+        const T temp = ycocg - _halve(cg);
+        const T green = (cg + temp) & mask;
+        const T blue = (temp - _halve(co)) & mask;
+        const T red = (blue + co) & mask;
+        return red | (green << 8) | (blue << 16) | (ycocg & T(0xff000000u));
+    }
+
+    static inline void swizzle(const uint32_t input, uint8_t& one, uint8_t& two,
+                               uint8_t& three, uint8_t& four)
+    {
+        NoSwizzle::swizzle(transform(input), one, two, three, four);
+    }
+
+    static inline void swizzle(const uint32_t input, uint8_t& one, uint8_t& two,
+                               uint8_t& three)
+    {
+        NoSwizzle::swizzle(transform(input), one, two, three);
+    }
+
+    static inline uint32_t deswizzle(const uint8_t one, const uint8_t two,
+                                     const uint8_t three, const uint8_t four)
+    {
+        return inverse(NoSwizzle::deswizzle(one, two, three, four));
+    }
+
+    static inline uint32_t deswizzle(const uint8_t one, const uint8_t two,
+                                     const uint8_t three)
+    {
+        return inverse(NoSwizzle::deswizzle(one, two, three));
+    }
+
+private:
+    // Arithmetic shift right of a signed byte in the lowest byte
+    template <typename T>
+    static inline T _halve(const T& value)
+    {
+        return (value >> 1) | (value & T(0x80u));
     }
 };
 }
@@ -187,12 +364,10 @@ void CompressorRLE4B::compress(const void* const inData,
 {
     if (useAlpha)
         _nResults =
-            _compress<uint32_t, uint8_t, NoSwizzle, UseAlpha>(inData, nPixels,
-                                                              _results);
+            _compressPlanar<NoSwizzle, UseAlpha>(inData, nPixels, _results);
     else
         _nResults =
-            _compress<uint32_t, uint8_t, NoSwizzle, NoAlpha>(inData, nPixels,
-                                                             _results);
+            _compressPlanar<NoSwizzle, NoAlpha>(inData, nPixels, _results);
 }
 
 void CompressorRLE4B::decompress(const void* const* inData,
@@ -204,13 +379,11 @@ void CompressorRLE4B::decompress(const void* const* inData,
     const eq_uint64_t nPixels =
         (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
     if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
-        _decompress<uint32_t, uint8_t, NoSwizzle, NoAlpha>(inData, inSizes,
-                                                           numInputs, outData,
-                                                           nPixels);
+        _decompressPlanar<uint32_t, uint8_t, NoSwizzle, NoAlpha>(
+            inData, inSizes, numInputs, outData, nPixels);
     else
-        _decompress<uint32_t, uint8_t, NoSwizzle, UseAlpha>(inData, inSizes,
-                                                            numInputs, outData,
-                                                            nPixels);
+        _decompressPlanar<uint32_t, uint8_t, NoSwizzle, UseAlpha>(
+            inData, inSizes, numInputs, outData, nPixels);
 }
 
 void CompressorDiffRLE4B::compress(const void* const inData,
@@ -219,14 +392,10 @@ void CompressorDiffRLE4B::compress(const void* const inData,
 {
     if (useAlpha)
         _nResults =
-            _compress<uint32_t, uint8_t, SwizzleUInt32, UseAlpha>(inData,
-                                                                  nPixels,
-                                                                  _results);
+            _compressPlanar<SwizzleUInt32, UseAlpha>(inData, nPixels, _results);
     else
         _nResults =
-            _compress<uint32_t, uint8_t, SwizzleUInt24, NoAlpha>(inData,
-                                                                 nPixels,
-                                                                 _results);
+            _compressPlanar<SwizzleUInt24, NoAlpha>(inData, nPixels, _results);
 }
 
 void CompressorDiffRLE4B::decompress(const void* const* inData,
@@ -239,15 +408,283 @@ void CompressorDiffRLE4B::decompress(const void* const* inData,
     const eq_uint64_t nPixels =
         (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
     if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
-        _decompress<uint32_t, uint8_t, SwizzleUInt24, NoAlpha>(inData, inSizes,
-                                                               numInputs,
-                                                               outData,
-                                                               nPixels);
+        _decompressPlanar<uint32_t, uint8_t, SwizzleUInt24, NoAlpha>(
+            inData, inSizes, numInputs, outData, nPixels);
+    else
+        _decompressPlanar<uint32_t, uint8_t, SwizzleUInt32, UseAlpha>(
+            inData, inSizes, numInputs, outData, nPixels);
+}
+
+void CompressorYCoCgRLE4B::compress(const void* const inData,
+                                    const eq_uint64_t nPixels,
+                                    const bool useAlpha)
+{
+    if (useAlpha)
+        _nResults = _compressPlanar<SwizzleYCoCg<SwizzleUInt32>, UseAlpha>(
+            inData, nPixels, _results);
+    else
+        _nResults = _compressPlanar<SwizzleYCoCg<SwizzleUInt24>, NoAlpha>(
+            inData, nPixels, _results);
+}
+
+void CompressorYCoCgRLE4B::decompress(const void* const* inData,
+                                      const eq_uint64_t* const inSizes,
+                                      const unsigned numInputs,
+                                      void* const outData,
+                                      eq_uint64_t* const outDims,
+                                      const eq_uint64_t flags, void* const)
+{
+    const eq_uint64_t nPixels =
+        (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
+    if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
+        _decompressPlanar<uint32_t, uint8_t, SwizzleYCoCg<SwizzleUInt24>,
+                          NoAlpha>(
+            inData, inSizes, numInputs, outData, nPixels);
+    else
+        _decompressPlanar<uint32_t, uint8_t, SwizzleYCoCg<SwizzleUInt32>,
+                          UseAlpha>(
+            inData, inSizes, numInputs, outData, nPixels);
+}
+
+void CompressorRLETile4B::compress(const void* const inData,
+                                   const eq_uint64_t* inDims,
+                                   const eq_uint64_t flags)
+{
+    if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
+        _nResults =
+            _compressTiles<NoSwizzle, NoAlpha>(inData, inDims, flags, _results);
+    else
+        _nResults = _compressTiles<NoSwizzle, UseAlpha>(inData, inDims, flags,
+                                                        _results);
+}
+
+void CompressorRLETile4B::decompress(const void* const* inData,
+                                     const eq_uint64_t* const inSizes,
+                                     const unsigned numInputs,
+                                     void* const outData,
+                                     eq_uint64_t* const outDims,
+                                     const eq_uint64_t flags, void* const)
+{
+    if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
+        _decompressTiles<uint32_t, uint8_t, NoSwizzle, NoAlpha>(
+            inData, inSizes, numInputs, outData, outDims, flags);
+    else
+        _decompressTiles<uint32_t, uint8_t, NoSwizzle, UseAlpha>(
+            inData, inSizes, numInputs, outData, outDims, flags);
+}
+
+void CompressorDiffRLETile4B::compress(const void* const inData,
+                                       const eq_uint64_t* inDims,
+                                       const eq_uint64_t flags)
+{
+    if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
+        _nResults = _compressTiles<SwizzleUInt24, NoAlpha>(inData, inDims,
+                                                           flags, _results);
+    else
+        _nResults = _compressTiles<SwizzleUInt32, UseAlpha>(inData, inDims,
+                                                            flags, _results);
+}
+
+void CompressorDiffRLETile4B::decompress(const void* const* inData,
+                                         const eq_uint64_t* const inSizes,
+                                         const unsigned numInputs,
+                                         void* const outData,
+                                         eq_uint64_t* const outDims,
+                                         const eq_uint64_t flags, void* const)
+{
+    if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
+        _decompressTiles<uint32_t, uint8_t, SwizzleUInt24, NoAlpha>(
+            inData, inSizes, numInputs, outData, outDims, flags);
+    else
+        _decompressTiles<uint32_t, uint8_t, SwizzleUInt32, UseAlpha>(
+            inData, inSizes, numInputs, outData, outDims, flags);
+}
+
+void CompressorRLEDelta4B::compress(const void* const inData,
+                                    const eq_uint64_t nPixels,
+                                    const bool useAlpha)
+{
+    const eq_uint64_t size = nPixels * sizeof(uint32_t);
+    DeltaHeader header;
+    header.frame = _frame + 1;
+    header.reference = _frame;
+    _frame = header.frame;
+
+    const void* input = inData;
+    if (_reference.getSize() != size || useAlpha != _useAlpha ||
+        header.frame - _keyFrame >= _keyFrameInterval)
+    {
+        header.reference = header.frame;
+        _keyFrame = header.frame;
+        _useAlpha = useAlpha;
+        _reference.replace(inData, size);
+    }
+    else
+    {
+        _residual.resize(size);
+        _delta(reinterpret_cast<const uint8_t*>(inData), _reference.getData(),
+               _residual.getData(), size);
+        input = _residual.getData();
+    }
+
+    if (useAlpha)
+        _nResults =
+            _compressPlanar<NoSwizzle, UseAlpha>(input, nPixels, _results);
+    else
+        _nResults =
+            _compressPlanar<NoSwizzle, NoAlpha>(input, nPixels, _results);
+
+    if (_results.size() == _nResults)
+        _results.push_back(new Result);
+    _results[_nResults++]->replace(&header, sizeof(header));
+}
+
+void CompressorRLEDelta4B::decompress(const void* const* inData,
+                                      const eq_uint64_t* const inSizes,
+                                      const unsigned numInputs,
+                                      void* const outData,
+                                      eq_uint64_t* const outDims,
+                                      const eq_uint64_t flags,
+                                      void* const decompressor)
+{
+    assert(numInputs > 0 && inSizes[numInputs - 1] == sizeof(DeltaHeader));
+    const eq_uint64_t nPixels =
+        (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
+    if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
+        _decompressPlanar<uint32_t, uint8_t, NoSwizzle, NoAlpha>(
+            inData, inSizes, numInputs - 1, outData, nPixels);
     else
-        _decompress<uint32_t, uint8_t, SwizzleUInt32, UseAlpha>(inData, inSizes,
-                                                                numInputs,
-                                                                outData,
-                                                                nPixels);
+        _decompressPlanar<uint32_t, uint8_t, NoSwizzle, UseAlpha>(
+            inData, inSizes, numInputs - 1, outData, nPixels);
+
+    DeltaHeader header;
+    ::memcpy(&header, inData[numInputs - 1], sizeof(header));
+
+    assert(decompressor);
+    static_cast<CompressorRLEDelta4B*>(static_cast<Compressor*>(decompressor))
+        ->_applyDelta(header.frame, header.reference, outData,
+                      nPixels * sizeof(uint32_t));
+}
+
+void CompressorRLEDelta4B::_applyDelta(const eq_uint64_t frame,
+                                       const eq_uint64_t reference,
+                                       void* const outData,
+                                       const eq_uint64_t size)
+{
+    uint8_t* const data = reinterpret_cast<uint8_t*>(outData);
+    const eq_uint64_t previous = _frame;
+    _frame = frame;
+    if (frame == reference) // keyframe
+    {
+        _reference.replace(data, size);
+        return;
+    }
+
+    if (_reference.getSize() != size)
+    {
+        LBWARN << "Missing reference frame " << reference << " for delta frame "
+               << frame << ", clearing output until the next keyframe"
+               << std::endl;
+        ::memset(data, 0, size);
+        _reference.clear();
+        return;
+    }
+    if (reference != previous)
+        LBWARN << "Missing reference frame " << reference << " for delta frame "
+               << frame << ", applying it to frame " << previous
+               << " until the next keyframe" << std::endl;
+    _undelta(data, _reference.getData(), size);
+}
+
+void CompressorRLEDirty4B::compress(const void* const inData,
+                                    const eq_uint64_t* inDims,
+                                    const eq_uint64_t flags)
+{
+    const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
+    DirtyTileHeader header;
+    header.tiles = _getTileHeader(inDims, flags);
+    header.frame = _frame + 1;
+    header.reference = _frame;
+    _frame = header.frame;
+
+    const eq_uint64_t width = header.tiles.dims[1];
+    const eq_uint64_t size = width * header.tiles.dims[3] * sizeof(uint32_t);
+    if (_reference.getSize() != size || width != _width ||
+        useAlpha != _useAlpha || header.frame - _keyFrame >= _keyFrameInterval)
+    {
+        header.reference = header.frame;
+        _keyFrame = header.frame;
+        _width = width;
+        _useAlpha = useAlpha;
+        _reference.replace(inData, size);
+    }
+
+    const CompressChunk_t compressChunk =
+        useAlpha ? _getCompressChunk<NoSwizzle, UseAlpha>()
+                 : _getCompressChunk<NoSwizzle, NoAlpha>();
+    _nResults = _compressDirtyTiles(inData, _reference.getData(), header,
+                                    sizeof(uint32_t), compressChunk, _results);
+}
+
+void CompressorRLEDirty4B::decompress(const void* const* inData,
+                                      const eq_uint64_t* const inSizes,
+                                      const unsigned numInputs,
+                                      void* const outData,
+                                      eq_uint64_t* const outDims,
+                                      const eq_uint64_t flags,
+                                      void* const decompressor)
+{
+    assert(numInputs > 0 && inSizes[0] >= sizeof(DirtyTileHeader));
+    DirtyTileHeader header;
+    ::memcpy(&header, inData[0], sizeof(header));
+    const eq_uint64_t size =
+        header.tiles.dims[1] * header.tiles.dims[3] * sizeof(uint32_t);
+    assert(size == ((flags & EQ_COMPRESSOR_DATA_1D)
+                        ? outDims[1]
+                        : outDims[1] * outDims[3]) *
+                       sizeof(uint32_t));
+
+    assert(decompressor);
+    uint8_t* const reference =
+        static_cast<CompressorRLEDirty4B*>(static_cast<Compressor*>(
+            decompressor))->_getReference(header.frame, header.reference, size);
+
+    const DecompressChunk_t decompressChunk =
+        (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
+            ? _getDecompressChunk<uint32_t, uint8_t, NoSwizzle, NoAlpha>()
+            : _getDecompressChunk<uint32_t, uint8_t, NoSwizzle, UseAlpha>();
+    _decompressDirtyTiles(inData, inSizes, numInputs, reference,
+                          sizeof(uint32_t), decompressChunk);
+    ::memcpy(outData, reference, size);
+}
+
+uint8_t* CompressorRLEDirty4B::_getReference(const eq_uint64_t frame,
+                                             const eq_uint64_t reference,
+                                             const eq_uint64_t size)
+{
+    const eq_uint64_t previous = _frame;
+    _frame = frame;
+    if (frame == reference) // keyframe, all tiles are patched
+    {
+        _reference.resize(size);
+        return _reference.getData();
+    }
+
+    if (_reference.getSize() != size)
+    {
+        if (!_reference.isEmpty())
+            LBWARN << "Missing reference frame " << reference
+                   << " for dirty tiles of frame " << frame
+                   << ", waiting for the next keyframe" << std::endl;
+        _reference.resize(size);
+        _reference.setZero();
+    }
+    else if (reference != previous)
+        LBWARN << "Missing reference frame " << reference
+               << " for dirty tiles of frame " << frame
+               << ", patching frame " << previous << " until the next keyframe"
+               << std::endl;
+    return _reference.getData();
 }
 }
 }
@@ -73,6 +73,193 @@ public:
                            eq_uint64_t* const outDims, const eq_uint64_t flags,
                            void* const);
 };
+
+/**
+ * RLE compression of the YCoCg-R transform of the color components, which
+ * decorrelates them for longer runs in the chroma planes. The transformed
+ * pixels are bit swizzled like in CompressorDiffRLE4B.
+ */
+class CompressorYCoCgRLE4B : public CompressorRLE4B
+{
+public:
+    CompressorYCoCgRLE4B()
+        : CompressorRLE4B()
+    {
+    }
+    virtual ~CompressorYCoCgRLE4B() {}
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorYCoCgRLE4B;
+    }
+
+    void compress(const void* const inData, const eq_uint64_t nPixels,
+                  const bool useAlpha) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+};
+
+/**
+ * RLE compression of 2D images in independent tiles, which are decompressed in
+ * parallel and only for the region of interest given by outDims.
+ */
+class CompressorRLETile4B : public Compressor
+{
+public:
+    CompressorRLETile4B()
+        : Compressor()
+    {
+    }
+    virtual ~CompressorRLETile4B() {}
+    using Compressor::compress;
+    void compress(const void* const inData, const eq_uint64_t* inDims,
+                  const eq_uint64_t flags) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorRLETile4B;
+    }
+};
+
+class CompressorDiffRLETile4B : public CompressorRLETile4B
+{
+public:
+    CompressorDiffRLETile4B()
+        : CompressorRLETile4B()
+    {
+    }
+    virtual ~CompressorDiffRLETile4B() {}
+    /** get a new instance of tiled compressor RLE 4 bytes and swizzle data. */
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorDiffRLETile4B;
+    }
+
+    void compress(const void* const inData, const eq_uint64_t* inDims,
+                  const eq_uint64_t flags) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+};
+
+/**
+ * RLE compression of consecutive frames relative to the previous frame.
+ *
+ * Every keyframe interval, and whenever the image size changes, a keyframe is
+ * compressed without reference. The decompressor instance keeps the previous
+ * frame. When it missed a frame, it applies the following deltas to its stale
+ * frame until the next keyframe resynchronizes it. A decompressor without any
+ * previous frame, e.g., one joining a running stream, clears the output of
+ * delta frames until the next keyframe. A new compressor instance,
+ * e.g., after pression::Compressor::realloc(), starts with a keyframe.
+ */
+class CompressorRLEDelta4B : public Compressor
+{
+public:
+    CompressorRLEDelta4B()
+        : Compressor()
+        , _frame(0)
+        , _keyFrame(0)
+        , _useAlpha(true)
+    {
+    }
+    virtual ~CompressorRLEDelta4B() {}
+    void compress(const void* const inData, const eq_uint64_t nPixels,
+                  const bool useAlpha) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const decompressor);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorRLEDelta4B;
+    }
+
+    /** The decompressor has to keep the previous frame. */
+    static Compressor* getNewDecompressor(const unsigned /*name*/)
+    {
+        return new CompressorRLEDelta4B;
+    }
+
+private:
+    lunchbox::Bufferb _reference; //!< the previous frame
+    lunchbox::Bufferb _residual;  //!< the delta to the previous frame
+    eq_uint64_t _frame;           //!< the number of the previous frame
+    eq_uint64_t _keyFrame;        //!< the number of the last keyframe
+    bool _useAlpha;
+
+    void _applyDelta(const eq_uint64_t frame, const eq_uint64_t reference,
+                     void* const outData, const eq_uint64_t size);
+};
+
+/**
+ * RLE compression of the tiles changed since the previous frame.
+ *
+ * The compressor compares each tile with the previous frame, and compresses
+ * only the changed tiles together with a bitmap of their positions. The
+ * decompressor instance patches them into its copy of the previous frame. As
+ * for CompressorRLEDelta4B, keyframes compress all tiles and resynchronize
+ * decompressors which missed a frame.
+ */
+class CompressorRLEDirty4B : public Compressor
+{
+public:
+    CompressorRLEDirty4B()
+        : Compressor()
+        , _width(0)
+        , _frame(0)
+        , _keyFrame(0)
+        , _useAlpha(true)
+    {
+    }
+    virtual ~CompressorRLEDirty4B() {}
+    using Compressor::compress;
+    void compress(const void* const inData, const eq_uint64_t* inDims,
+                  const eq_uint64_t flags) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const decompressor);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorRLEDirty4B;
+    }
+
+    /** The decompressor has to keep the previous frame. */
+    static Compressor* getNewDecompressor(const unsigned /*name*/)
+    {
+        return new CompressorRLEDirty4B;
+    }
+
+private:
+    lunchbox::Bufferb _reference; //!< the previous frame
+    eq_uint64_t _width;           //!< the width of the previous frame
+    eq_uint64_t _frame;           //!< the number of the previous frame
+    eq_uint64_t _keyFrame;        //!< the number of the last keyframe
+    bool _useAlpha;
+
+    uint8_t* _getReference(const eq_uint64_t frame,
+                           const eq_uint64_t reference,
+                           const eq_uint64_t size);
+};
 }
 }
 #endif // PRESSION_PLUGIN_COMPRESSORRLE4B
@@ -0,0 +1,217 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorRLE4F.h"
+
+namespace
+{
+static const uint8_t _rleMarker = 0x42; // just a random number
+}
+
+#include "compressorRLE.ipp"
+
+namespace pression
+{
+namespace plugin
+{
+namespace
+{
+REGISTER_ENGINE(CompressorRLE4F, RGBA32F, RGBA32F, 1., .8, 1., false);
+REGISTER_ENGINE(CompressorRLE4F, BGRA32F, BGRA32F, 1., .8, 1., false);
+REGISTER_ENGINE(CompressorDiffRLE4F, DIFF_RGBA32F, RGBA32F, 1., .2, .9, false);
+REGISTER_ENGINE(CompressorDiffRLE4F, DIFF_BGRA32F, BGRA32F, 1., .2, .9, false);
+REGISTER_ENGINE(CompressorRLE1F, R32F, R32F, 1., .5, 1., false);
+REGISTER_ENGINE(CompressorDiffRLE1F, DIFF_R32F, R32F, 1., .55, .9, false);
+
+// The floats are predicted in independent blocks, which are decompressed in
+// parallel. The first pixel of each block is kept.
+const eq_uint64_t _predictionSize = 65536; // floats per block
+
+class NoSwizzle
+{
+public:
+    template <typename T>
+    static inline T transform(const T& input)
+    {
+        return input;
+    }
+
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return input;
+    }
+
+    static inline void swizzle(const uint32_t input, uint8_t& one, uint8_t& two,
+                               uint8_t& three, uint8_t& four)
+    {
+        one = input & 0xff;
+        two = (input & 0xff00) >> 8;
+        three = (input & 0xff0000) >> 16;
+        four = (input & 0xff000000) >> 24;
+    }
+
+    static inline void swizzle(const uint32_t, uint8_t&, uint8_t&, uint8_t&)
+    {
+        assert(0);
+    }
+
+    static inline uint32_t deswizzle(const uint8_t one, const uint8_t two,
+                                     const uint8_t three, const uint8_t four)
+    {
+        return one + (two << 8) + (three << 16) + (uint32_t(four) << 24);
+    }
+
+    static inline uint32_t deswizzle(const uint8_t, const uint8_t,
+                                     const uint8_t)
+    {
+        assert(0);
+        return 0;
+    }
+};
+
+// residual = input ^ the same channel of the previous pixel in the block
+void _predict(const uint32_t* const input, uint32_t* const residual,
+              const eq_uint64_t nFloats, const eq_uint64_t nChannels)
+{
+    const eq_uint64_t nBlocks = (nFloats + _predictionSize - 1) /
+                                _predictionSize;
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nBlocks); ++i)
+    {
+        const eq_uint64_t start = i * _predictionSize;
+        const eq_uint64_t end = std::min(start + _predictionSize, nFloats);
+        const eq_uint64_t first = std::min(start + nChannels, end);
+        for (eq_uint64_t j = start; j < first; ++j)
+            residual[j] = input[j];
+        for (eq_uint64_t j = first; j < end; ++j)
+            residual[j] = input[j] ^ input[j - nChannels];
+    }
+}
+
+// Reverts _predict() in place
+void _unpredict(uint32_t* const data, const eq_uint64_t nFloats,
+                const eq_uint64_t nChannels)
+{
+    const eq_uint64_t nBlocks = (nFloats + _predictionSize - 1) /
+                                _predictionSize;
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nBlocks); ++i)
+    {
+        const eq_uint64_t start = i * _predictionSize;
+        const eq_uint64_t end = std::min(start + _predictionSize, nFloats);
+        for (eq_uint64_t j = start + nChannels; j < end; ++j)
+            data[j] ^= data[j - nChannels];
+    }
+}
+
+inline eq_uint64_t _getNumPixels(const eq_uint64_t* const outDims,
+                                 const eq_uint64_t flags)
+{
+    return (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1]
+                                           : outDims[1] * outDims[3];
+}
+}
+
+void CompressorRLE4F::compress(const void* const inData,
+                               const eq_uint64_t nPixels, const bool /*alpha*/)
+{
+    _nResults =
+        _compressPlanar<NoSwizzle, UseAlpha>(inData, nPixels * 4, _results);
+}
+
+void CompressorRLE4F::decompress(const void* const* inData,
+                                 const eq_uint64_t* const inSizes,
+                                 const unsigned numInputs, void* const outData,
+                                 eq_uint64_t* const outDims,
+                                 const eq_uint64_t flags, void* const)
+{
+    _decompressPlanar<uint32_t, uint8_t, NoSwizzle, UseAlpha>(
+        inData, inSizes, numInputs, outData, _getNumPixels(outDims, flags) * 4);
+}
+
+void CompressorDiffRLE4F::compress(const void* const inData,
+                                   const eq_uint64_t nPixels,
+                                   const bool /*alpha*/)
+{
+    _compressFloats(inData, nPixels * 4, 4);
+}
+
+void CompressorDiffRLE4F::decompress(const void* const* inData,
+                                     const eq_uint64_t* const inSizes,
+                                     const unsigned numInputs,
+                                     void* const outData,
+                                     eq_uint64_t* const outDims,
+                                     const eq_uint64_t flags, void* const)
+{
+    const eq_uint64_t nFloats = _getNumPixels(outDims, flags) * 4;
+    _decompressPlanar<uint32_t, uint8_t, NoSwizzle, UseAlpha>(
+        inData, inSizes, numInputs, outData, nFloats);
+    _unpredict(reinterpret_cast<uint32_t*>(outData), nFloats, 4);
+}
+
+void CompressorDiffRLE4F::_compressFloats(const void* const inData,
+                                          const eq_uint64_t nFloats,
+                                          const eq_uint64_t nChannels)
+{
+    _residual.resize(nFloats * sizeof(uint32_t));
+    uint32_t* const residual = reinterpret_cast<uint32_t*>(_residual.getData());
+    _predict(reinterpret_cast<const uint32_t*>(inData), residual, nFloats,
+             nChannels);
+    _nResults =
+        _compressPlanar<NoSwizzle, UseAlpha>(residual, nFloats, _results);
+}
+
+void CompressorRLE1F::compress(const void* const inData,
+                               const eq_uint64_t nPixels, const bool /*alpha*/)
+{
+    _nResults = _compressPlanar<NoSwizzle, UseAlpha>(inData, nPixels, _results);
+}
+
+void CompressorRLE1F::decompress(const void* const* inData,
+                                 const eq_uint64_t* const inSizes,
+                                 const unsigned numInputs, void* const outData,
+                                 eq_uint64_t* const outDims,
+                                 const eq_uint64_t flags, void* const)
+{
+    _decompressPlanar<uint32_t, uint8_t, NoSwizzle, UseAlpha>(
+        inData, inSizes, numInputs, outData, _getNumPixels(outDims, flags));
+}
+
+void CompressorDiffRLE1F::compress(const void* const inData,
+                                   const eq_uint64_t nPixels,
+                                   const bool /*alpha*/)
+{
+    _compressFloats(inData, nPixels, 1);
+}
+
+void CompressorDiffRLE1F::decompress(const void* const* inData,
+                                     const eq_uint64_t* const inSizes,
+                                     const unsigned numInputs,
+                                     void* const outData,
+                                     eq_uint64_t* const outDims,
+                                     const eq_uint64_t flags, void* const)
+{
+    const eq_uint64_t nFloats = _getNumPixels(outDims, flags);
+    _decompressPlanar<uint32_t, uint8_t, NoSwizzle, UseAlpha>(
+        inData, inSizes, numInputs, outData, nFloats);
+    _unpredict(reinterpret_cast<uint32_t*>(outData), nFloats, 1);
+}
+}
+}
@@ -0,0 +1,138 @@
+
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef PRESSION_PLUGIN_COMPRESSORRLE4F
+#define PRESSION_PLUGIN_COMPRESSORRLE4F
+
+#include "compressor.h"
+
+namespace pression
+{
+namespace plugin
+{
+/** RLE compression of the four byte planes of RGBA float pixels. */
+class CompressorRLE4F : public Compressor
+{
+public:
+    CompressorRLE4F()
+        : Compressor()
+    {
+    }
+    virtual ~CompressorRLE4F() {}
+    void compress(const void* const inData, const eq_uint64_t nPixels,
+                  const bool useAlpha) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorRLE4F;
+    }
+};
+
+/**
+ * RLE compression of RGBA float pixels XOR'ed with the previous pixel.
+ *
+ * Each byte plane of the RGBA floats interleaves the four channels, which
+ * breaks its runs. Neighbouring pixels mostly share the sign, exponent and
+ * upper mantissa bits of each channel, which the XOR clears, giving long runs
+ * of zeros in the upper byte planes.
+ */
+class CompressorDiffRLE4F : public CompressorRLE4F
+{
+public:
+    CompressorDiffRLE4F()
+        : CompressorRLE4F()
+    {
+    }
+    virtual ~CompressorDiffRLE4F() {}
+    void compress(const void* const inData, const eq_uint64_t nPixels,
+                  const bool useAlpha) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorDiffRLE4F;
+    }
+
+protected:
+    void _compressFloats(const void* const inData, const eq_uint64_t nFloats,
+                         const eq_uint64_t nChannels);
+
+private:
+    lunchbox::Bufferb _residual; //!< the input XOR'ed with the previous pixel
+};
+
+/** RLE compression of the four byte planes of single channel floats. */
+class CompressorRLE1F : public CompressorRLE4F
+{
+public:
+    CompressorRLE1F()
+        : CompressorRLE4F()
+    {
+    }
+    virtual ~CompressorRLE1F() {}
+    void compress(const void* const inData, const eq_uint64_t nPixels,
+                  const bool useAlpha) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorRLE1F;
+    }
+};
+
+/** RLE compression of single channel floats XOR'ed with the previous one. */
+class CompressorDiffRLE1F : public CompressorDiffRLE4F
+{
+public:
+    CompressorDiffRLE1F()
+        : CompressorDiffRLE4F()
+    {
+    }
+    virtual ~CompressorDiffRLE1F() {}
+    void compress(const void* const inData, const eq_uint64_t nPixels,
+                  const bool useAlpha) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           eq_uint64_t* const outDims, const eq_uint64_t flags,
+                           void* const);
+
+    static Compressor* getNewCompressor(const unsigned /*name*/)
+    {
+        return new CompressorDiffRLE1F;
+    }
+};
+}
+}
+#endif // PRESSION_PLUGIN_COMPRESSORRLE4F
@@ -40,6 +40,12 @@ REGISTER_ENGINE(CompressorDiffRLE4HF, DIFF_BGRA16F, BGRA16F, 1., 0.9, 1., true);
 class NoSwizzle
 {
 public:
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return input;
+    }
+
     static inline void swizzle(const uint64_t input, uint16_t& one,
                                uint16_t& two, uint16_t& three, uint16_t& four)
     {
@@ -73,9 +79,23 @@ public:
     }
 };
 
-class Swizzle
+class SwizzleUInt64
 {
 public:
+    /** Bit operations of deswizzle(), for one uint64_t or for Pixels. */
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return (input & T(0xffc0000007c0001full)) |
+               ((input & T(0x7e0ull)) << 11) |
+               ((input & T(0x3ff800ull)) << 21) |
+               ((input & T(0x30000ff8000000ull)) >> 22) |
+               ((input & T(0x7000000000ull)) >> 9) |
+               ((input & T(0x1f8000000000ull)) << 9) |
+               ((input & T(0x3e00000000000ull)) >> 2) |
+               ((input & T(0xc000000000000ull)) >> 36);
+    }
+
     static inline void swizzle(const uint64_t input, uint16_t& one,
                                uint16_t& two, uint16_t& three, uint16_t& four)
     {
@@ -90,6 +110,52 @@ public:
                            one, two, three, four);
     }
 
+    static inline void swizzle(const uint64_t, uint16_t&, uint16_t&, uint16_t&)
+    {
+        assert(0);
+    }
+
+    static inline uint64_t deswizzle(const uint16_t one, const uint16_t two,
+                                     const uint16_t three, const uint16_t four)
+    {
+        return inverse(NoSwizzle::deswizzle(one, two, three, four));
+    }
+
+    static inline uint64_t deswizzle(const uint16_t, const uint16_t,
+                                     const uint16_t)
+    {
+        assert(0);
+        return 0;
+    }
+};
+
+class SwizzleUInt48
+{
+public:
+    /** Bit operations of deswizzle(), for one uint64_t or for Pixels. */
+    template <typename T>
+    static inline T inverse(const T& input)
+    {
+        return (input & T(0xc073070c380ull)) |
+               ((input & T(0xfull)) << 38) | // one
+               ((input & T(0x70ull)) << 19) | ((input & T(0xc00ull)) << 36) |
+               ((input & T(0xc003000ull)) << 18) |
+
+               ((input & T(0xf0000ull)) >> 13) | // two
+               ((input & T(0x3800000ull)) << 12) |
+
+               ((input & T(0xc00000000000ull)) >> 36) | // three
+               ((input & T(0x38000000000ull)) >> 39) |
+               ((input & T(0x3000c0000000ull)) >> 18) |
+               ((input & T(0x7800000000ull)) >> 19);
+    }
+
+    static inline void swizzle(const uint64_t, uint16_t&, uint16_t&, uint16_t&,
+                               uint16_t&)
+    {
+        assert(0);
+    }
+
     static inline void swizzle(const uint64_t input, uint16_t& one,
                                uint16_t& two, uint16_t& three)
     {
@@ -109,35 +175,17 @@ public:
                            one, two, three);
     }
 
-    static inline uint64_t deswizzle(const uint16_t one, const uint16_t two,
-                                     const uint16_t three, const uint16_t four)
+    static inline uint64_t deswizzle(const uint16_t, const uint16_t,
+                                     const uint16_t, const uint16_t)
     {
-        uint64_t output = NoSwizzle::deswizzle(one, two, three, four);
-
-        return ((output & 0xffc0000007c0001full) | ((output & 0x7e0ull) << 11) |
-                ((output & 0x3ff800ull) << 21) |
-                ((output & 0x30000ff8000000ull) >> 22) |
-                ((output & 0x7000000000ull) >> 9) |
-                ((output & 0x1f8000000000ull) << 9) |
-                ((output & 0x3e00000000000ull) >> 2) |
-                ((output & 0xc000000000000ull) >> 36));
+        assert(0);
+        return 0;
     }
 
     static inline uint64_t deswizzle(const uint16_t one, const uint16_t two,
                                      const uint16_t three)
     {
-        uint64_t output = NoSwizzle::deswizzle(one, two, three);
-        return (output & 0xc073070c380ull) | ((output & 0xfull) << 38) | // one
-               ((output & 0x70ull) << 19) | ((output & 0xc00ull) << 36) |
-               ((output & 0xc003000ull) << 18) |
-
-               ((output & 0xf0000ull) >> 13) | // two
-               ((output & 0x3800000ull) << 12) |
-
-               ((output & 0xc00000000000ull) >> 36) | // three
-               ((output & 0x38000000000ull) >> 39) |
-               ((output & 0x3000c0000000ull) >> 18) |
-               ((output & 0x7800000000ull) >> 19);
+        return inverse(NoSwizzle::deswizzle(one, two, three));
     }
 };
 }
@@ -164,13 +212,11 @@ void CompressorRLE4HF::decompress(const void* const* inData,
     const eq_uint64_t nPixels =
         (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
     if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
-        _decompress<uint64_t, uint16_t, NoSwizzle, NoAlpha>(inData, inSizes,
-                                                            nInputs, outData,
-                                                            nPixels);
+        _decompressPlanar<uint64_t, uint16_t, NoSwizzle, NoAlpha>(
+            inData, inSizes, nInputs, outData, nPixels);
     else
-        _decompress<uint64_t, uint16_t, NoSwizzle, UseAlpha>(inData, inSizes,
-                                                             nInputs, outData,
-                                                             nPixels);
+        _decompressPlanar<uint64_t, uint16_t, NoSwizzle, UseAlpha>(
+            inData, inSizes, nInputs, outData, nPixels);
 }
 
 void CompressorDiffRLE4HF::compress(const void* const inData,
@@ -179,12 +225,14 @@ void CompressorDiffRLE4HF::compress(const void* const inData,
 {
     if (useAlpha)
         _nResults =
-            _compress<uint64_t, uint16_t, Swizzle, UseAlpha>(inData, nPixels,
-                                                             _results);
+            _compress<uint64_t, uint16_t, SwizzleUInt64, UseAlpha>(inData,
+                                                                   nPixels,
+                                                                   _results);
     else
         _nResults =
-            _compress<uint64_t, uint16_t, Swizzle, NoAlpha>(inData, nPixels,
-                                                            _results);
+            _compress<uint64_t, uint16_t, SwizzleUInt48, NoAlpha>(inData,
+                                                                  nPixels,
+                                                                  _results);
 }
 
 void CompressorDiffRLE4HF::decompress(const void* const* inData,
@@ -197,13 +245,11 @@ void CompressorDiffRLE4HF::decompress(const void* const* inData,
     const eq_uint64_t nPixels =
         (flags & EQ_COMPRESSOR_DATA_1D) ? outDims[1] : outDims[1] * outDims[3];
     if (flags & EQ_COMPRESSOR_IGNORE_ALPHA)
-        _decompress<uint64_t, uint16_t, Swizzle, NoAlpha>(inData, inSizes,
-                                                          nInputs, outData,
-                                                          nPixels);
+        _decompressPlanar<uint64_t, uint16_t, SwizzleUInt48, NoAlpha>(
+            inData, inSizes, nInputs, outData, nPixels);
     else
-        _decompress<uint64_t, uint16_t, Swizzle, UseAlpha>(inData, inSizes,
-                                                           nInputs, outData,
-                                                           nPixels);
+        _decompressPlanar<uint64_t, uint16_t, SwizzleUInt64, UseAlpha>(
+            inData, inSizes, nInputs, outData, nPixels);
 }
 }
 }
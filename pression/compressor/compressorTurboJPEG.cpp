@@ -19,6 +19,8 @@
 
 #include "compressorTurboJPEG.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <math.h>
 
@@ -34,61 +36,127 @@ namespace
 static int _version; // Eq plugin API version
 typedef const char* (*GetKey_t)();
 
-#define REGISTER_ENGINE(token_, name_, quality_, ratio_, speed_, alpha)  \
-    static void _getInfoTurbo##token_##name_##alpha(                     \
-        EqCompressorInfo* const info)                                    \
-    {                                                                    \
-        _version = info->version;                                        \
-        info->version = EQ_COMPRESSOR_VERSION;                           \
-        info->capabilities = EQ_COMPRESSOR_DATA_2D;                      \
-        if (alpha)                                                       \
-            info->capabilities |= EQ_COMPRESSOR_IGNORE_ALPHA;            \
-        info->quality = quality_##f;                                     \
-        info->ratio = ratio_##f;                                         \
-        info->speed = speed_##f;                                         \
-        info->name = EQ_COMPRESSOR_CH_EYESCALE_JPEG_##token_##name_;     \
-        info->tokenType = EQ_COMPRESSOR_DATATYPE_##token_;               \
-        if (alpha)                                                       \
-        {                                                                \
-            if (_version > 2)                                            \
-            {                                                            \
-                info->outputTokenType = EQ_COMPRESSOR_DATATYPE_##token_; \
-                info->outputTokenSize = 3;                               \
-            }                                                            \
-        }                                                                \
-        else if (_version < 3)                                           \
-            info->tokenType = EQ_COMPRESSOR_DATATYPE_INVALID;            \
-    }                                                                    \
-                                                                         \
-    static bool _registerTurbo##token_##name_##alpha()                   \
-    {                                                                    \
-        Compressor::registerEngine(Compressor::Functions(                \
-            EQ_COMPRESSOR_CH_EYESCALE_JPEG_##token_##name_,              \
-            _getInfoTurbo##token_##name_##alpha,                         \
-            CompressorTurboJPEG::getNewCompressor,                       \
-            CompressorTurboJPEG::getNewCompressor,                       \
-            CompressorTurboJPEG::decompress, 0));                        \
-        return true;                                                     \
-    }                                                                    \
-                                                                         \
-    static bool LB_UNUSED _initialized##token_##name_##alpha =           \
-        _registerTurbo##token_##name_##alpha();
-
-REGISTER_ENGINE(RGBA, 100, 0.95, 0.33, 0.34, true);
-REGISTER_ENGINE(BGRA, 100, 0.95, 0.33, 0.34, true);
-
-REGISTER_ENGINE(RGBA, 90, 0.9, 0.09, 0.65, true);
-REGISTER_ENGINE(BGRA, 90, 0.9, 0.09, 0.65, true);
-
-REGISTER_ENGINE(RGBA, 80, 0.8, 0.07, 0.75, true);
-REGISTER_ENGINE(BGRA, 80, 0.8, 0.07, 0.75, true);
-
-REGISTER_ENGINE(RGB, 100, 0.95, 0.3, 1.2, false);
-REGISTER_ENGINE(RGB, 90, 0.9, 0.3, 1.2, false);
-REGISTER_ENGINE(RGB, 80, 0.8, 0.3, 1.2, false);
-REGISTER_ENGINE(BGR, 100, 0.95, 0.3, 1.2, false);
-REGISTER_ENGINE(BGR, 90, 0.9, 0.3, 1.2, false);
-REGISTER_ENGINE(BGR, 80, 0.8, 0.3, 1.2, false);
+// Rows per stripe of the striped engines, a multiple of the MCU height
+const eq_uint64_t _stripeRows = 128;
+
+bool _isTunable(const unsigned name)
+{
+    return name >= EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_RGBA &&
+           name <= EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_BGR;
+}
+
+bool _isStriped(const unsigned name)
+{
+    return _isTunable(name) ||
+           (name >= EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA100 &&
+            name <= EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR80);
+}
+
+#define REGISTER_ENGINE(name_, token_, quality_, ratio_, speed_, alpha)   \
+    static void _getInfoTurbo##name_##alpha(EqCompressorInfo* const info) \
+    {                                                                     \
+        _version = info->version;                                         \
+        info->version = EQ_COMPRESSOR_VERSION;                            \
+        info->capabilities = EQ_COMPRESSOR_DATA_2D;                       \
+        if (alpha)                                                        \
+            info->capabilities |= EQ_COMPRESSOR_IGNORE_ALPHA;             \
+        if (_isTunable(EQ_COMPRESSOR_CH_EYESCALE_JPEG_##name_))           \
+            info->capabilities |= EQ_COMPRESSOR_PARAMETERS;               \
+        info->quality = quality_##f;                                      \
+        info->ratio = ratio_##f;                                          \
+        info->speed = speed_##f;                                          \
+        info->name = EQ_COMPRESSOR_CH_EYESCALE_JPEG_##name_;              \
+        info->tokenType = EQ_COMPRESSOR_DATATYPE_##token_;                \
+        if (alpha)                                                        \
+        {                                                                 \
+            if (_version > 2)                                             \
+            {                                                             \
+                info->outputTokenType = EQ_COMPRESSOR_DATATYPE_##token_;  \
+                info->outputTokenSize = 3;                                \
+            }                                                             \
+        }                                                                 \
+        else if (_version < 3)                                            \
+            info->tokenType = EQ_COMPRESSOR_DATATYPE_INVALID;             \
+    }                                                                     \
+                                                                          \
+    static bool _registerTurbo##name_##alpha()                            \
+    {                                                                     \
+        Compressor::registerEngine(Compressor::Functions(                 \
+            EQ_COMPRESSOR_CH_EYESCALE_JPEG_##name_,                       \
+            _getInfoTurbo##name_##alpha,                                  \
+            CompressorTurboJPEG::getNewCompressor,                        \
+            CompressorTurboJPEG::getNewCompressor,                        \
+            CompressorTurboJPEG::decompress, 0));                         \
+        return true;                                                      \
+    }                                                                     \
+                                                                          \
+    static bool LB_UNUSED _initialized##name_##alpha =                    \
+        _registerTurbo##name_##alpha();
+
+REGISTER_ENGINE(RGBA100, RGBA, 0.95, 0.33, 0.34, true);
+REGISTER_ENGINE(BGRA100, BGRA, 0.95, 0.33, 0.34, true);
+
+REGISTER_ENGINE(RGBA90, RGBA, 0.9, 0.09, 0.65, true);
+REGISTER_ENGINE(BGRA90, BGRA, 0.9, 0.09, 0.65, true);
+
+REGISTER_ENGINE(RGBA80, RGBA, 0.8, 0.07, 0.75, true);
+REGISTER_ENGINE(BGRA80, BGRA, 0.8, 0.07, 0.75, true);
+
+REGISTER_ENGINE(RGB100, RGB, 0.95, 0.3, 1.2, false);
+REGISTER_ENGINE(RGB90, RGB, 0.9, 0.3, 1.2, false);
+REGISTER_ENGINE(RGB80, RGB, 0.8, 0.3, 1.2, false);
+REGISTER_ENGINE(BGR100, BGR, 0.95, 0.3, 1.2, false);
+REGISTER_ENGINE(BGR90, BGR, 0.9, 0.3, 1.2, false);
+REGISTER_ENGINE(BGR80, BGR, 0.8, 0.3, 1.2, false);
+
+// Each stripe is a separate JPEG image with its own headers, which costs a
+// little ratio for encoding and decoding the stripes in parallel.
+REGISTER_ENGINE(STRIPED_RGBA100, RGBA, 0.95, 0.34, 0.68, true);
+REGISTER_ENGINE(STRIPED_BGRA100, BGRA, 0.95, 0.34, 0.68, true);
+
+REGISTER_ENGINE(STRIPED_RGBA90, RGBA, 0.9, 0.1, 1.3, true);
+REGISTER_ENGINE(STRIPED_BGRA90, BGRA, 0.9, 0.1, 1.3, true);
+
+REGISTER_ENGINE(STRIPED_RGBA80, RGBA, 0.8, 0.08, 1.5, true);
+REGISTER_ENGINE(STRIPED_BGRA80, BGRA, 0.8, 0.08, 1.5, true);
+
+REGISTER_ENGINE(STRIPED_RGB100, RGB, 0.95, 0.31, 2.4, false);
+REGISTER_ENGINE(STRIPED_RGB90, RGB, 0.9, 0.31, 2.4, false);
+REGISTER_ENGINE(STRIPED_RGB80, RGB, 0.8, 0.31, 2.4, false);
+REGISTER_ENGINE(STRIPED_BGR100, BGR, 0.95, 0.31, 2.4, false);
+REGISTER_ENGINE(STRIPED_BGR90, BGR, 0.9, 0.31, 2.4, false);
+REGISTER_ENGINE(STRIPED_BGR80, BGR, 0.8, 0.31, 2.4, false);
+
+// The tunable engines default to the quality of the 90 engines.
+REGISTER_ENGINE(TUNABLE_RGBA, RGBA, 0.9, 0.1, 1.2, true);
+REGISTER_ENGINE(TUNABLE_BGRA, BGRA, 0.9, 0.1, 1.2, true);
+REGISTER_ENGINE(TUNABLE_RGB, RGB, 0.9, 0.31, 2.2, false);
+REGISTER_ENGINE(TUNABLE_BGR, BGR, 0.9, 0.31, 2.2, false);
+
+// The rate control works on the logarithm of the percentage by which the
+// quality scales the quantization tables. JPEG sizes fall about linearly with
+// it, by a slope of 0.2 to 0.6 over all qualities, while their growth per
+// quality step varies tenfold. The slope is estimated from the last two frames.
+const float _defaultSlope = 0.4f;
+const float _minSlope = 0.1f;
+const float _maxSlope = 1.f;
+const float _maxScaleStep = 0.7f;   // at most halve or double the scale
+const float _sizeTolerance = 0.05f; // relative size error left uncorrected
+
+// @return the quantization scale in percent used by libjpeg for a quality
+float _getScale(const eq_uint64_t quality)
+{
+    if (quality < 50)
+        return 5000.f / float(quality);
+    return std::max(200.f - 2.f * float(quality), 1.f);
+}
+
+eq_uint64_t _getQuality(const float scale)
+{
+    const float quality =
+        std::round(scale > 100.f ? 5000.f / scale : 100.f - scale * .5f);
+    return eq_uint64_t(std::min(std::max(quality, 1.f), 100.f));
+}
 }
 
 CompressorTurboJPEG::CompressorTurboJPEG(const unsigned name)
@@ -96,45 +164,66 @@ CompressorTurboJPEG::CompressorTurboJPEG(const unsigned name)
     , _quality(100)
     , _tokenSize(4)
     , _flags(0)
-    , _encoder(0)
-    , _decoder(0)
+    , _stripeHeight(_isStriped(name) ? _stripeRows : 0)
+    , _subsampling(TJ_444)
+    , _tunable(_isTunable(name))
+    , _targetSize(0)
+    , _lastQuality(0)
+    , _lastSize(0)
+    , _lastPixels(0)
 {
     switch (name)
     {
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGRA80:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGRA80:
         _flags = TJ_BGR;
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGBA80:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA80:
         _quality = 80;
         break;
 
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGRA90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGRA90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_BGRA:
         _flags = TJ_BGR;
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGBA90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_RGBA:
         _quality = 90;
         break;
 
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGRA100:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGRA100:
         _flags = TJ_BGR;
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGBA100:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA100:
         break;
 
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGR80:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR80:
         _flags = TJ_BGR;
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGB80:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGB80:
         _quality = 80;
         _tokenSize = 3;
         break;
 
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGR90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_BGR:
         _flags = TJ_BGR;
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGB90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGB90:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_RGB:
         _quality = 90;
         _tokenSize = 3;
         break;
 
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGR100:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR100:
         _flags = TJ_BGR;
     case EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGB100:
+    case EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGB100:
         _tokenSize = 3;
         break;
 
@@ -143,53 +232,169 @@ CompressorTurboJPEG::CompressorTurboJPEG(const unsigned name)
     }
 
     _flags = _flags | TJ_FASTUPSAMPLE;
-    _results.push_back(new Result); // RGB jpeg
-    _results.push_back(new Result); // Alpha uncompressed TODO RLE
 }
 
 CompressorTurboJPEG::~CompressorTurboJPEG()
 {
-    if (_decoder)
-        tjDestroy(_decoder);
-    _decoder = 0;
+    for (void* decoder : _decoders)
+        tjDestroy(decoder);
+    _decoders.clear();
+
+    for (void* encoder : _encoders)
+        tjDestroy(encoder);
+    _encoders.clear();
+}
+
+eq_uint64_t CompressorTurboJPEG::_getStripeHeight(
+    const eq_uint64_t height) const
+{
+    return _stripeHeight ? _stripeHeight : height;
+}
 
-    if (_encoder)
-        tjDestroy(_encoder);
-    _encoder = 0;
+eq_uint64_t CompressorTurboJPEG::_getNumStripes(const eq_uint64_t height) const
+{
+    return _stripeHeight ? (height + _stripeHeight - 1) / _stripeHeight : 1;
 }
 
+// The results are one JPEG image per stripe, followed by the uncompressed
+// alpha channel of the whole frame.
 void CompressorTurboJPEG::compress(const void* const inData,
                                    const eq_uint64_t* inDims,
                                    const eq_uint64_t flags)
 {
-    assert(!_decoder);
+    assert(_decoders.empty());
     assert(flags & EQ_COMPRESSOR_DATA_2D);
 
-    if (!_encoder)
-        _encoder = tjInitCompress();
+    const eq_uint64_t width = inDims[1];
+    const eq_uint64_t height = inDims[3];
+    const eq_uint64_t stripeHeight = _getStripeHeight(height);
+    const eq_uint64_t nStripes = _getNumStripes(height);
+    const bool useAlpha =
+        !(flags & EQ_COMPRESSOR_IGNORE_ALPHA) && _tokenSize == 4;
 
-    const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
-    if (useAlpha && _tokenSize == 4)
+    _nResults = unsigned(useAlpha ? nStripes + 1 : nStripes);
+    while (_results.size() < _nResults)
+        _results.push_back(new Result);
+    while (_encoders.size() < nStripes)
+        _encoders.push_back(tjInitCompress());
+
+    Result* const alpha = useAlpha ? _results[nStripes] : 0;
+    if (alpha)
+        alpha->resize(width * height);
+
+    const unsigned char* const in =
+        reinterpret_cast<const unsigned char*>(inData);
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nStripes); ++i)
+    {
+        const eq_uint64_t y = i * stripeHeight;
+        const eq_uint64_t nRows = std::min(stripeHeight, height - y);
+        const unsigned char* const stripe = in + y * width * _tokenSize;
+
+        if (alpha)
+            _extractAlpha(stripe, alpha->getData() + y * width,
+                          width * nRows);
+        _compressStripe(stripe, width, nRows, _encoders[i], *_results[i]);
+    }
+
+    if (_targetSize)
     {
-        const eq_uint64_t size = inDims[3] * inDims[1];
-        _extractAlpha(reinterpret_cast<const unsigned char*>(inData), size);
-        _nResults = 2;
+        eq_uint64_t size = 0;
+        for (unsigned i = 0; i < _nResults; ++i)
+            size += _results[i]->getSize();
+        _adjustQuality(width * height, size);
     }
-    else
-        _nResults = 1;
+}
 
-    _results[0]->resize(TJBUFSIZE(inDims[1], inDims[3]));
+bool CompressorTurboJPEG::setParameter(const unsigned parameter,
+                                       const eq_uint64_t value)
+{
+    if (!_tunable)
+        return false;
+
+    switch (parameter)
+    {
+    case EQ_COMPRESSOR_PARAMETER_QUALITY:
+        if (value < 1 || value > 100)
+            return false;
+        _quality = value;
+        return true;
+
+    case EQ_COMPRESSOR_PARAMETER_SUBSAMPLING:
+        switch (value)
+        {
+        case EQ_COMPRESSOR_SUBSAMPLING_444:
+            _subsampling = TJ_444;
+            return true;
+        case EQ_COMPRESSOR_SUBSAMPLING_422:
+            _subsampling = TJ_422;
+            return true;
+        case EQ_COMPRESSOR_SUBSAMPLING_420:
+            _subsampling = TJ_420;
+            return true;
+        default:
+            return false;
+        }
+
+    case EQ_COMPRESSOR_PARAMETER_TARGET_SIZE:
+        _targetSize = value;
+        _lastPixels = 0;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+// Steps the quality towards the target size, assuming the next frame
+// compresses like this one.
+void CompressorTurboJPEG::_adjustQuality(const eq_uint64_t nPixels,
+                                         const eq_uint64_t size)
+{
+    if (size == 0)
+        return;
+
+    const float scale = std::log(_getScale(_quality));
+    float slope = _defaultSlope;
+    if (nPixels == _lastPixels && _quality != _lastQuality)
+    {
+        const float secant = std::log(float(_lastSize) / float(size)) /
+                             (scale - std::log(_getScale(_lastQuality)));
+        if (secant > 0.f)
+            slope = std::min(std::max(secant, _minSlope), _maxSlope);
+    }
+    _lastQuality = _quality;
+    _lastSize = size;
+    _lastPixels = nPixels;
+
+    const float error = std::log(float(_targetSize) / float(size));
+    if (std::abs(error) < _sizeTolerance)
+        return;
+
+    const float step =
+        std::min(std::max(error / slope, -_maxScaleStep), _maxScaleStep);
+    _quality = _getQuality(std::exp(scale - step));
+}
+
+void CompressorTurboJPEG::_compressStripe(const unsigned char* const inData,
+                                          const eq_uint64_t width,
+                                          const eq_uint64_t nRows,
+                                          void* const encoder,
+                                          Result& result) const
+{
+    result.resize(TJBUFSIZE(width, nRows));
     unsigned long size = 0;
 
-    void* const data = const_cast<void* const>(inData);
-    if (tjCompress(_encoder, reinterpret_cast<unsigned char*>(data), inDims[1],
-                   inDims[1] * _tokenSize, inDims[3], _tokenSize,
-                   _results[0]->getData(), &size, TJ_444, _quality, _flags))
+    unsigned char* const data = const_cast<unsigned char*>(inData);
+    if (tjCompress(encoder, data, width, width * _tokenSize, nRows,
+                   _tokenSize, result.getData(), &size, _subsampling,
+                   _quality, _flags))
     {
         assert(false);
         size = 0;
     }
-    _results[0]->resize(size);
+    result.resize(size);
 }
 
 void CompressorTurboJPEG::decompress(
@@ -198,44 +403,60 @@ void CompressorTurboJPEG::decompress(
     const eq_uint64_t flags, void* const instance)
 {
     const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
-    static_cast<CompressorTurboJPEG*>(instance)->_decompress(inData, inSizes[0],
+    static_cast<CompressorTurboJPEG*>(instance)->_decompress(inData, inSizes,
                                                              nInputs, outData,
                                                              outDims, useAlpha);
 }
 
 void CompressorTurboJPEG::_decompress(const void* const* inData,
-                                      const eq_uint64_t inSize,
+                                      const eq_uint64_t* const inSizes,
                                       const unsigned nInputs LB_UNUSED,
                                       void* const outData,
                                       eq_uint64_t* const outDims,
                                       const bool useAlpha)
 {
-    assert(!_encoder);
-    if (!_decoder)
-        _decoder = tjInitDecompress();
-    void* const data = const_cast<void* const>(inData[0]);
-
-    if (tjDecompress(_decoder, reinterpret_cast<unsigned char*>(data), inSize,
-                     reinterpret_cast<unsigned char*>(outData), outDims[1],
-                     outDims[1] * _tokenSize, outDims[3], _tokenSize, _flags))
-    {
-        assert(false);
-    }
-    else if (useAlpha && _tokenSize == 4)
+    assert(_encoders.empty());
+
+    const eq_uint64_t width = outDims[1];
+    const eq_uint64_t height = outDims[3];
+    const eq_uint64_t stripeHeight = _getStripeHeight(height);
+    const eq_uint64_t nStripes = _getNumStripes(height);
+    const void* const alpha =
+        useAlpha && _tokenSize == 4 ? inData[nStripes] : 0;
+    assert(nInputs == (alpha ? nStripes + 1 : nStripes));
+
+    while (_decoders.size() < nStripes)
+        _decoders.push_back(tjInitDecompress());
+
+    unsigned char* const out = reinterpret_cast<unsigned char*>(outData);
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < static_cast<ssize_t>(nStripes); ++i)
     {
-        assert(nInputs == 2);
-        const eq_uint64_t size = outDims[3] * outDims[1];
-        _addAlpha(inData[1], reinterpret_cast<unsigned*>(outData), size);
+        const eq_uint64_t y = i * stripeHeight;
+        const eq_uint64_t nRows = std::min(stripeHeight, height - y);
+        unsigned char* const stripe = out + y * width * _tokenSize;
+        unsigned char* const data =
+            reinterpret_cast<unsigned char*>(const_cast<void*>(inData[i]));
+
+        if (tjDecompress(_decoders[i], data, inSizes[i], stripe, width,
+                         width * _tokenSize, nRows, _tokenSize, _flags))
+        {
+            assert(false);
+        }
+        else if (alpha)
+            _addAlpha(reinterpret_cast<const unsigned char*>(alpha) +
+                          y * width,
+                      reinterpret_cast<unsigned*>(stripe), width * nRows);
     }
 }
 
 void CompressorTurboJPEG::_extractAlpha(const unsigned char* inData,
-                                        const eq_uint64_t nPixels)
+                                        unsigned char* alpha,
+                                        const eq_uint64_t nPixels) const
 {
-    _results[1]->resize(nPixels);
-
     const unsigned char* end = inData + nPixels * 4;
-    unsigned char* dst = _results[1]->getData();
+    unsigned char* dst = alpha;
     for (const unsigned char* src = (inData + 3); src < end; src += 4)
     {
         *dst = *src;
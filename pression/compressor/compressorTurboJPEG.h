@@ -36,6 +36,8 @@ public:
 
     void compress(const void* const inData, const eq_uint64_t* inDims,
                   const eq_uint64_t flags) override;
+    bool setParameter(const unsigned parameter,
+                      const eq_uint64_t value) override;
 
     static void decompress(const void* const* inData,
                            const eq_uint64_t* const inSizes,
@@ -52,14 +54,31 @@ private:
     eq_uint64_t _quality;
     eq_uint64_t _tokenSize;
     eq_uint64_t _flags;
+    eq_uint64_t _stripeHeight; //!< rows per JPEG image, 0 for the whole frame
+    int _subsampling;
+    const bool _tunable;
 
-    void* _encoder;
-    void* _decoder;
+    eq_uint64_t _targetSize; //!< compressed frame size to aim for, or 0
+    eq_uint64_t _lastQuality;
+    eq_uint64_t _lastSize;
+    eq_uint64_t _lastPixels;
 
-    void _decompress(const void* const* inData, const eq_uint64_t inSize,
-                     const unsigned nInputs, void* const outData,
-                     eq_uint64_t* const outDims, const bool useAlpha);
-    void _extractAlpha(const unsigned char* inData, const eq_uint64_t nPixels);
+    std::vector<void*> _encoders; //!< one per stripe
+    std::vector<void*> _decoders; //!< one per stripe
+
+    eq_uint64_t _getStripeHeight(const eq_uint64_t height) const;
+    eq_uint64_t _getNumStripes(const eq_uint64_t height) const;
+    void _adjustQuality(const eq_uint64_t nPixels, const eq_uint64_t size);
+
+    void _compressStripe(const unsigned char* const inData,
+                         const eq_uint64_t width, const eq_uint64_t nRows,
+                         void* const encoder, Result& result) const;
+    void _decompress(const void* const* inData,
+                     const eq_uint64_t* const inSizes, const unsigned nInputs,
+                     void* const outData, eq_uint64_t* const outDims,
+                     const bool useAlpha);
+    void _extractAlpha(const unsigned char* inData, unsigned char* alpha,
+                       const eq_uint64_t nPixels) const;
     void _addAlpha(const void* const inAlpha, unsigned* out,
                    const eq_uint64_t nPixels) const;
 };
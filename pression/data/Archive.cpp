@@ -0,0 +1,293 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This file is part of Pression <https://github.com/Eyescale/Pression>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Archive.h"
+
+#include "Compressor.h"
+#include "Registry.h"
+
+#include <lunchbox/memoryMap.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace pression
+{
+namespace data
+{
+namespace
+{
+const uint64_t _magic = 0x3143524153455250ull; // "PRESARC1"
+const uint64_t _flagChecksum = 1;
+const size_t _nameSize = 64;
+const size_t _batchSize = 64; // chunks compressed in parallel by write()
+
+// Layout: chunks, nChunks + 1 chunk offsets, Footer. Offsets and footer fields
+// are stored little endian.
+struct Footer
+{
+    char engine[_nameSize];
+    uint64_t size;
+    uint64_t chunkSize;
+    uint64_t nChunks;
+    uint64_t flags;
+    uint64_t magic;
+};
+
+// Converts between native and little endian, a no-op on little endian hosts
+inline uint64_t _littleEndian(const uint64_t value)
+{
+    uint8_t bytes[sizeof(value)];
+    for (size_t i = 0; i < sizeof(value); ++i)
+        bytes[i] = uint8_t(value >> (i * 8));
+    uint64_t result;
+    ::memcpy(&result, bytes, sizeof(result));
+    return result;
+}
+
+void _swapFooter(Footer& footer)
+{
+    footer.size = _littleEndian(footer.size);
+    footer.chunkSize = _littleEndian(footer.chunkSize);
+    footer.nChunks = _littleEndian(footer.nChunks);
+    footer.flags = _littleEndian(footer.flags);
+    footer.magic = _littleEndian(footer.magic);
+}
+}
+
+class Archive::Impl
+{
+public:
+    explicit Impl(const std::string& filename)
+        : map(filename)
+        , base(map.getAddress<uint8_t>())
+    {
+        const size_t fileSize = map.getSize();
+        if (!base || fileSize < sizeof(Footer))
+            LBTHROW(std::runtime_error("Can't map archive " + filename));
+
+        ::memcpy(&footer, base + fileSize - sizeof(Footer), sizeof(Footer));
+        _swapFooter(footer);
+        const uint64_t indexSize = (footer.nChunks + 1) * sizeof(uint64_t);
+        if (footer.magic != _magic || footer.chunkSize == 0 ||
+            footer.nChunks > fileSize / sizeof(uint64_t) ||
+            indexSize > fileSize - sizeof(Footer) ||
+            footer.nChunks != (footer.size + footer.chunkSize - 1) /
+                                  footer.chunkSize)
+        {
+            LBTHROW(std::runtime_error(filename + " is not an archive"));
+        }
+
+        // index is unaligned in the file
+        const size_t indexStart = fileSize - sizeof(Footer) - indexSize;
+        offsets.resize(footer.nChunks + 1);
+        ::memcpy(offsets.data(), base + indexStart, indexSize);
+        for (uint64_t& offset : offsets)
+            offset = _littleEndian(offset);
+        for (size_t i = 0; i < footer.nChunks; ++i)
+            if (offsets[i] > offsets[i + 1])
+                LBTHROW(std::runtime_error("Corrupt index in " + filename));
+        if (offsets.back() > indexStart)
+            LBTHROW(std::runtime_error("Corrupt index in " + filename));
+
+        engine = std::string(footer.engine,
+                             ::strnlen(footer.engine, _nameSize));
+        compressor.reset(Registry::getInstance().find(engine).create());
+        if (!compressor)
+            LBTHROW(std::runtime_error("Unknown compression engine " + engine +
+                                       " in " + filename));
+        compressor->setChecksum(footer.flags & _flagChecksum);
+    }
+
+    void willNeed(const size_t first, const size_t last) const
+    {
+#ifdef _WIN32
+        (void)first;
+        (void)last;
+#else
+        static const size_t pageSize = ::sysconf(_SC_PAGESIZE);
+        const size_t start = offsets[first] / pageSize * pageSize;
+        ::posix_madvise(const_cast<uint8_t*>(base) + start,
+                        offsets[last + 1] - start, POSIX_MADV_WILLNEED);
+#endif
+    }
+
+    lunchbox::MemoryMap map;
+    const uint8_t* const base;
+    Footer footer;
+    std::vector<uint64_t> offsets;
+    std::string engine;
+    std::unique_ptr<Compressor> compressor;
+};
+
+void Archive::write(const std::string& filename, const CompressorInfo& info,
+                    const uint8_t* const data, const size_t size,
+                    const bool checksum)
+{
+    std::unique_ptr<Compressor> compressor(info.create());
+    if (!compressor)
+        LBTHROW(std::runtime_error("Unknown compression engine " + info.name));
+    if (info.name.size() >= _nameSize)
+        LBTHROW(std::runtime_error("Compression engine name " + info.name +
+                                   " too long for archive"));
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        LBTHROW(std::runtime_error("Can't open " + filename + " for writing"));
+
+    const Compressor::Clock::time_point start = Compressor::Clock::now();
+    compressor->setChecksum(checksum);
+    const size_t chunkSize = compressor->_getChunkSize();
+    const size_t nChunks = (size + chunkSize - 1) / chunkSize;
+    std::vector<uint64_t> offsets(nChunks + 1, 0);
+    Compressor::Results results(std::min(_batchSize, nChunks));
+    int failed = -1; // exceptions can't leave the parallel region
+
+    for (size_t batch = 0; batch < nChunks; batch += _batchSize)
+    {
+        const size_t nResults = std::min(_batchSize, nChunks - batch);
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < int(nResults); ++i)
+        {
+            const size_t begin = (batch + i) * chunkSize;
+            const size_t nBytes = std::min(chunkSize, size - begin);
+            if (!compressor->_compressChunk(data + begin, nBytes, results[i]))
+            {
+#pragma omp atomic write
+                failed = int(batch) + i;
+            }
+        }
+        if (failed >= 0)
+            LBTHROW(std::runtime_error("Compression of archive chunk " +
+                                       std::to_string(failed) + " failed"));
+
+        for (size_t i = 0; i < nResults; ++i)
+        {
+            const size_t j = batch + i;
+            file.write(reinterpret_cast<const char*>(results[i].getData()),
+                       results[i].getSize());
+            offsets[j + 1] = offsets[j] + results[i].getSize();
+        }
+    }
+
+    Footer footer;
+    ::memset(&footer, 0, sizeof(footer));
+    ::memcpy(footer.engine, info.name.data(), info.name.size());
+    footer.size = size;
+    footer.chunkSize = chunkSize;
+    footer.nChunks = nChunks;
+    footer.flags = checksum ? _flagChecksum : 0;
+    footer.magic = _magic;
+    _swapFooter(footer);
+
+    const size_t compressedSize = offsets.back();
+    for (uint64_t& offset : offsets)
+        offset = _littleEndian(offset);
+    file.write(reinterpret_cast<const char*>(offsets.data()),
+               offsets.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    file.close();
+    if (!file)
+        LBTHROW(std::runtime_error("Write error in " + filename));
+    compressor->_record(true, size, compressedSize, start);
+}
+
+Archive::Archive(const std::string& filename)
+    : _impl(new Impl(filename))
+{
+}
+
+Archive::~Archive()
+{
+}
+
+size_t Archive::getSize() const
+{
+    return _impl->footer.size;
+}
+
+const std::string& Archive::getEngine() const
+{
+    return _impl->engine;
+}
+
+void Archive::read(uint8_t* const data, const size_t offset, const size_t size)
+{
+    if (offset > _impl->footer.size || size > _impl->footer.size - offset)
+        LBTHROW(std::runtime_error(
+            "Range of " + std::to_string(size) + " bytes at " +
+            std::to_string(offset) + " exceeds archive of " +
+            std::to_string(_impl->footer.size) + " bytes"));
+    if (size == 0)
+        return;
+
+    const Compressor::Clock::time_point startTime = Compressor::Clock::now();
+    const size_t chunkSize = _impl->footer.chunkSize;
+    const size_t first = offset / chunkSize;
+    const size_t last = (offset + size - 1) / chunkSize;
+    _impl->willNeed(first, last);
+
+    Compressor& compressor = *_impl->compressor;
+    int corrupt = -1; // exceptions can't leave the parallel region
+#pragma omp parallel for schedule(static)
+    for (int i = int(first); i <= int(last); ++i)
+    {
+        const size_t chunkStart = i * chunkSize;
+        const size_t chunkEnd =
+            std::min(chunkStart + chunkSize, size_t(_impl->footer.size));
+        const size_t start = std::max(chunkStart, offset);
+        const size_t end = std::min(chunkEnd, offset + size);
+        const uint8_t* input = _impl->base + _impl->offsets[i];
+        const size_t inputSize = _impl->offsets[i + 1] - _impl->offsets[i];
+
+        bool valid;
+        if (start == chunkStart && end == chunkEnd)
+            valid = compressor._decompressChunk(input, inputSize,
+                                                data + start - offset,
+                                                chunkEnd - chunkStart);
+        else // partial chunk at either end of the range
+        {
+            Compressor::Result chunk(chunkEnd - chunkStart);
+            valid = compressor._decompressChunk(input, inputSize,
+                                                chunk.getData(),
+                                                chunkEnd - chunkStart);
+            ::memcpy(data + start - offset,
+                     chunk.getData() + start - chunkStart, end - start);
+        }
+
+        if (!valid)
+        {
+#pragma omp atomic write
+            corrupt = i;
+        }
+    }
+
+    if (corrupt >= 0)
+        LBTHROW(std::runtime_error("Corrupt archive chunk " +
+                                   std::to_string(corrupt)));
+    compressor._record(false, _impl->offsets[last + 1] - _impl->offsets[first],
+                       size, startTime);
+}
+}
+}
@@ -0,0 +1,101 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This file is part of Pression <https://github.com/Eyescale/Pression>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <pression/data/api.h>
+#include <pression/data/types.h>
+
+#include <memory>
+#include <string>
+
+namespace pression
+{
+namespace data
+{
+/**
+ * A seekable file of compressed data.
+ *
+ * The file contains the compressed chunks of a single data buffer, followed
+ * by an index of the chunk offsets and a footer naming the compression engine.
+ * Archives are memory-mapped for reading, and read() decompresses only the
+ * chunks overlapping the requested range, in parallel and directly from the
+ * mapping.
+ *
+ * The index and footer are stored little endian. The chunks contain the
+ * output of the compression engine, which is not portable between hosts of
+ * different byte order for all engines.
+ */
+class Archive
+{
+public:
+    /**
+     * Compress the given data into a new archive file.
+     *
+     * @param filename the file to create or overwrite
+     * @param info the compression engine to use
+     * @param data pointer to data to compress
+     * @param size number of bytes to compress
+     * @param checksum store per-chunk integrity checks, see
+     *                 Compressor::setChecksum()
+     * @throw std::runtime_error if the engine is unknown, fails to compress a
+     *        chunk or on write errors
+     */
+    PRESSIONDATA_API static void write(const std::string& filename,
+                                       const CompressorInfo& info,
+                                       const uint8_t* data, size_t size,
+                                       bool checksum = true);
+
+    /**
+     * Open an existing archive for reading.
+     *
+     * @param filename the archive file produced by write()
+     * @throw std::runtime_error if the file is not a valid archive or uses an
+     *        unknown compression engine
+     */
+    PRESSIONDATA_API explicit Archive(const std::string& filename);
+    PRESSIONDATA_API ~Archive();
+
+    /** @return the uncompressed size of the archived data. */
+    PRESSIONDATA_API size_t getSize() const;
+
+    /** @return the name of the compression engine used by the archive. */
+    PRESSIONDATA_API const std::string& getEngine() const;
+
+    /**
+     * Decompress a range of the archived data.
+     *
+     * @param data pointer to pre-allocated memory for size bytes
+     * @param offset the start of the range in the uncompressed data
+     * @param size number of bytes to decompress
+     * @throw std::runtime_error if the range exceeds the archive or if a chunk
+     *        fails its integrity check or can't be decompressed
+     */
+    PRESSIONDATA_API void read(uint8_t* data, size_t offset, size_t size);
+
+private:
+    Archive(const Archive&) = delete;
+    Archive(Archive&&) = delete;
+    Archive& operator=(const Archive&) = delete;
+    Archive& operator=(Archive&&) = delete;
+
+    class Impl;
+    std::unique_ptr<Impl> _impl;
+};
+}
+}
@@ -18,47 +18,121 @@
  */
 
 #include "Compressor.h"
+#include "Trace.h"
+
+#include "xxhash.h"
+
+#include <lunchbox/thread.h>
 
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
+#ifdef PRESSION_USE_OPENMP
+#include <omp.h>
+#endif
+
+#ifdef PRESSION_TRACE
+#define PRESSION_TRACE_SPAN(name, bytesIn, bytesOut) \
+    detail::TraceSpan traceSpan(name, _name, bytesIn, bytesOut)
+#define PRESSION_TRACE_OUTPUT(bytesOut) traceSpan.setBytesOut(bytesOut)
+#else
+#define PRESSION_TRACE_SPAN(name, bytesIn, bytesOut)
+#define PRESSION_TRACE_OUTPUT(bytesOut)
+#endif
 
 namespace pression
 {
 namespace data
 {
+namespace
+{
+const size_t _checksumSize = sizeof(uint64_t);
+
+// set by engines through Compressor::setChunkFailed(), one chunk per thread
+thread_local bool _chunkFailed = false;
+
+// Thread 0 is the calling thread of the application and keeps its placement
+void _pinWorker()
+{
+#ifdef PRESSION_USE_OPENMP
+    const int thread = omp_get_thread_num();
+    if (thread > 0)
+        lunchbox::Thread::setAffinity(lunchbox::Thread::CORE + thread);
+#endif
+}
+}
+
 Compressor::~Compressor()
 {
-    if (_in > 0)
-        LBDEBUG << _in << " -> " << _out << " ("
-                << int(float(_out) / float(_in) * 100.f) << "%) " << std::endl;
+}
+
+void Compressor::setChunkFailed()
+{
+    _chunkFailed = true;
+}
+
+Statistics Compressor::getStatistics() const
+{
+    return _counters.get();
 }
 
 const Compressor::Results& Compressor::compress(const uint8_t* data,
                                                 size_t size)
 {
+    PRESSION_TRACE_SPAN("compress", size, 0);
+    const Clock::time_point startTime = Clock::now();
+    const size_t chunkSize = _getChunkSize();
+    if (size > 0 && size <= chunkSize) // small input, no thread dispatch
+    {
+        compressed.resize(1);
+        if (!_compressChunk(data, size, compressed[0]))
+            LBTHROW(std::runtime_error("Compression of " +
+                                       std::to_string(size) +
+                                       " bytes failed"));
+        _record(true, size, compressed[0].getSize(), startTime);
+        PRESSION_TRACE_OUTPUT(compressed[0].getSize());
+        return compressed;
+    }
+
 #ifdef PRESSION_USE_OPENMP
-    const size_t chunkSize = getChunkSize();
     const size_t nChunks = (size + chunkSize - 1) / chunkSize;
 
     compressed.resize(nChunks);
 
-#pragma omp parallel for
-    for (int i = 0; i < int(nChunks); ++i)
+    int failed = -1; // exceptions can't leave the parallel region
+#pragma omp parallel
     {
-        const size_t start = i * chunkSize;
-        const size_t end = std::min((i + 1) * chunkSize, size);
-        const size_t nBytes = end - start;
+        if (_affinity)
+            _pinWorker();
+
+        // contiguous blocks per worker, output allocated by the worker
+#pragma omp for schedule(static)
+        for (int i = 0; i < int(nChunks); ++i)
+        {
+            const size_t start = i * chunkSize;
+            const size_t end = std::min((i + 1) * chunkSize, size);
+            const size_t nBytes = end - start;
 
-        compressed[i].reserve(getCompressBound(nBytes));
-        compressChunk(data + start, nBytes, compressed[i]);
+            if (!_compressChunk(data + start, nBytes, compressed[i]))
+            {
+#pragma omp atomic write
+                failed = i;
+            }
+        }
     }
+
+    if (failed >= 0)
+        LBTHROW(std::runtime_error("Compression of chunk " +
+                                   std::to_string(failed) + " of " +
+                                   std::to_string(nChunks) + " failed"));
 #else
     compressed.resize(1);
-    compressed[0].reserve(getCompressBound(size));
-    compressChunk(data, size, compressed[0]);
+    if (!_compressChunk(data, size, compressed[0]))
+        LBTHROW(std::runtime_error("Compression of " + std::to_string(size) +
+                                   " bytes failed"));
 #endif
-    _in += size;
-    _out += getDataSize(compressed);
+    _record(true, size, getDataSize(compressed), startTime);
+    PRESSION_TRACE_OUTPUT(getDataSize(compressed));
     return compressed;
 }
 
@@ -66,6 +140,15 @@ void Compressor::decompress(const Results& result, uint8_t* data, size_t size)
 {
     if (result.empty())
         return;
+    if (result.size() == 1) // small input, no input vector
+    {
+        PRESSION_TRACE_SPAN("decompress", result[0].getSize(), size);
+        const Clock::time_point startTime = Clock::now();
+        _decompressSingle(result[0].getData(), result[0].getSize(), data,
+                          size);
+        _record(false, result[0].getSize(), size, startTime);
+        return;
+    }
 
     std::vector<std::pair<const uint8_t*, size_t>> inputs(result.size());
     for (size_t i = 0; i < result.size(); ++i)
@@ -79,17 +162,21 @@ void Compressor::decompress(
 {
     if (inputs.empty())
         return;
-    _in += size;
+
+    const Clock::time_point startTime = Clock::now();
+    size_t inputSize = 0;
     for (const auto& input : inputs)
-        _out += input.second;
+        inputSize += input.second;
+    PRESSION_TRACE_SPAN("decompress", inputSize, size);
 
-    if (inputs.size() == 1) // compressor did not have OpenMP
+    if (inputs.size() == 1) // small input or compressor did not have OpenMP
     {
-        decompressChunk(inputs[0].first, inputs[0].second, data, size);
+        _decompressSingle(inputs[0].first, inputSize, data, size);
+        _record(false, inputSize, size, startTime);
         return;
     }
 
-    const size_t chunkSize = getChunkSize();
+    const size_t chunkSize = _getChunkSize();
     if (size / chunkSize != inputs.size() &&
         size / chunkSize + 1 != inputs.size())
     {
@@ -99,16 +186,101 @@ void Compressor::decompress(
             " input chunks for " + std::to_string(size) + " bytes"));
     }
 
-#pragma omp parallel for
-    for (int i = 0; i < int(inputs.size()); ++i)
+    int corrupt = -1; // exceptions can't leave the parallel region
+#pragma omp parallel
     {
-        const size_t start = i * chunkSize;
-        const size_t end = std::min((i + 1) * chunkSize, size);
-        const size_t nBytes = end - start;
+        if (_affinity)
+            _pinWorker();
+
+#pragma omp for schedule(static)
+        for (int i = 0; i < int(inputs.size()); ++i)
+        {
+            const size_t start = i * chunkSize;
+            const size_t end = std::min((i + 1) * chunkSize, size);
+            const size_t nBytes = end - start;
 
-        decompressChunk(inputs[i].first, inputs[i].second, data + start,
-                        nBytes);
+            if (!_decompressChunk(inputs[i].first, inputs[i].second,
+                                  data + start, nBytes))
+            {
+#pragma omp atomic write
+                corrupt = i;
+            }
+        }
     }
+
+    if (corrupt >= 0)
+        LBTHROW(std::runtime_error("Corrupt chunk " + std::to_string(corrupt) +
+                                   " of " + std::to_string(inputs.size())));
+    _record(false, inputSize, size, startTime);
+}
+
+void Compressor::_record(const bool compress, const size_t bytesIn,
+                         const size_t bytesOut, const Clock::time_point& start)
+{
+    const uint64_t time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             start)
+            .count();
+    _counters.add(compress, bytesIn, bytesOut, time);
+    if (_engineCounters)
+        _engineCounters->add(compress, bytesIn, bytesOut, time);
+}
+
+void Compressor::_decompressSingle(const uint8_t* input,
+                                   const size_t inputSize,
+                                   uint8_t* const data, const size_t size)
+{
+    if (!_decompressChunk(input, inputSize, data, size))
+        LBTHROW(std::runtime_error("Corrupt data for " +
+                                   std::to_string(size) + " bytes"));
+}
+
+bool Compressor::_compressChunk(const uint8_t* data, const size_t size,
+                                Result& output)
+{
+    PRESSION_TRACE_SPAN("compressChunk", size, 0);
+    output.reserve(getCompressBound(size) + (_checksum ? _checksumSize : 0));
+    _chunkFailed = false;
+    compressChunk(data, size, output);
+    if (_chunkFailed)
+        return false;
+    _counters.addChunk(size, output.getSize());
+    if (_engineCounters)
+        _engineCounters->addChunk(size, output.getSize());
+    PRESSION_TRACE_OUTPUT(output.getSize());
+    if (!_checksum)
+        return true;
+
+    // hash while the compressed chunk is still in cache
+    const uint64_t hash = XXH64(output.getData(), output.getSize(), 0);
+    output.append(reinterpret_cast<const uint8_t*>(&hash), _checksumSize);
+    PRESSION_TRACE_OUTPUT(output.getSize());
+    return true;
+}
+
+bool Compressor::_decompressChunk(const uint8_t* input, const size_t inputSize,
+                                  uint8_t* const data, const size_t size)
+{
+    PRESSION_TRACE_SPAN("decompressChunk", inputSize, size);
+    _chunkFailed = false;
+    if (!_checksum)
+    {
+        decompressChunk(input, inputSize, data, size);
+        return !_chunkFailed;
+    }
+
+    if (inputSize < _checksumSize)
+        return false;
+
+    const size_t payloadSize = inputSize - _checksumSize;
+    uint64_t expected;
+    ::memcpy(&expected, input + payloadSize, _checksumSize);
+
+    // verify before decoding, corrupt input may crash the decompressor
+    if (XXH64(input, payloadSize, 0) != expected)
+        return false;
+    decompressChunk(input, payloadSize, data, size);
+    return !_chunkFailed;
 }
 }
 }
@@ -22,15 +22,22 @@
 #include <lunchbox/buffer.h>   // used inline
 #include <lunchbox/compiler.h> // LB_UNUSED
 #include <lunchbox/debug.h>    // LBUNIMPLEMENTED
+#include <pression/data/Statistics.h> // member
 #include <pression/data/api.h>
 #include <pression/data/types.h>
 
+#include <chrono>
+#include <memory>
+#include <string>
+
 namespace pression
 {
 namespace data
 {
 /**
- * Interface for lossless CPU compressors of binary data.
+ * Interface for CPU compressors of binary data.
+ *
+ * Compressors are lossless unless their CompressorInfo::errorBound is set.
  *
  * Implementers can choose to override compress() and decompress() for parallel
  * algorithms or compressChunk() and decompressChunk() for serial algorithms.
@@ -60,6 +67,7 @@ public:
      * @param data pointer to data to compress
      * @param size number of bytes to compress
      * @return the compressed data chunk(s)
+     * @throw std::runtime_error if the engine fails to compress a chunk
      */
     PRESSIONDATA_API virtual const Results& compress(const uint8_t* data,
                                                      size_t size);
@@ -67,13 +75,14 @@ public:
      * Decompress the given data.
      *
      * This default implementation will decompress the given input in parallel
-     * using the protected decompress() method, assuming getChunkSize() returns
-     * the same value as during the compress() operation.
+     * using the protected decompress() method, assuming the chunk size is the
+     * same as during the compress() operation.
      *
      * @param inputs compressed data chunk(s) produced by compress()
      * @param data pointer to pre-allocated memory for the decompressed data
      * @param size decompressed data size
-     * @throw std::runtime_error if chunksize does not match input
+     * @throw std::runtime_error if chunksize does not match input or if a
+     *        chunk fails its integrity check or can't be decompressed
      */
     PRESSIONDATA_API
     virtual void decompress(
@@ -86,10 +95,66 @@ public:
 
     /** @return the result of the last compress() operation. */
     const Results& getCompressedData() const { return compressed; }
+    /**
+     * @return the statistics of all operations of this compressor.
+     * @sa Registry::getStatistics() for statistics per engine.
+     */
+    PRESSIONDATA_API Statistics getStatistics() const;
+
+    /**
+     * Enable or disable per-chunk integrity checks.
+     *
+     * When enabled, compress() appends an XXH64 hash of each compressed chunk
+     * to the chunk, and decompress() verifies each chunk before decompressing
+     * it. The setting has to be the same for compression and decompression.
+     * Disabled by default.
+     */
+    void setChecksum(const bool enable) { _checksum = enable; }
+    /** @return true if per-chunk integrity checks are enabled. */
+    bool getChecksum() const { return _checksum; }
+    /**
+     * Enable or disable pinning of the worker threads.
+     *
+     * Chunks are statically scheduled in contiguous blocks, so worker n always
+     * processes the n-th block of the data, and it allocates and first-touches
+     * the output of its chunks. When enabled, compress() and decompress() bind
+     * worker n > 0 to core n using lunchbox::Thread::setAffinity(), which
+     * keeps the blocks on the NUMA node of the worker. Input first-touched by
+     * a statically scheduled parallel loop is then processed on its node.
+     * Worker 0 is the calling thread and is never pinned. The binding persists
+     * for the other threads of the OpenMP pool. Disabled by default, leaving
+     * placement to OMP_PROC_BIND and OMP_PLACES.
+     */
+    void setAffinity(const bool enable) { _affinity = enable; }
+    /** @return true if worker threads are pinned to cores. */
+    bool getAffinity() const { return _affinity; }
+    /**
+     * Override the chunk size used by compress() and decompress().
+     *
+     * The setting has to be the same for compression and decompression.
+     *
+     * @param size the chunk size in bytes, 0 for the engine's optimal size
+     */
+    void setChunkSize(const size_t size) { _chunkSize = size; }
+    /**
+     * Set the maximum absolute error per value for subsequent compressions.
+     *
+     * Only lossy engines, which publish CompressorInfo::errorBound, implement
+     * this method. Lossless engines ignore the setting.
+     *
+     * @param errorBound the maximum absolute error per value
+     * @return true if the engine uses the given bound, false otherwise
+     */
+    virtual bool setErrorBound(const double errorBound LB_UNUSED)
+    {
+        return false;
+    }
+
 protected:
     Compressor()
-        : _in(0)
-        , _out(0)
+        : _checksum(false)
+        , _affinity(false)
+        , _chunkSize(0)
     {
     }
     Compressor(const Compressor&) = delete;
@@ -134,11 +199,41 @@ protected:
         LBUNIMPLEMENTED
     }
 
+    /**
+     * Report a failure of the current compressChunk() or decompressChunk().
+     *
+     * Chunks are processed in parallel regions which exceptions must not
+     * leave. Implementations call this method and return instead of throwing;
+     * compress() and decompress() throw a std::runtime_error once all chunks
+     * are processed.
+     */
+    PRESSIONDATA_API static void setChunkFailed();
+
     Results compressed;
 
 private:
-    size_t _in;
-    size_t _out;
+    friend class Archive;
+    friend class Registry;
+    typedef std::chrono::steady_clock Clock;
+
+    detail::Counters _counters;
+    std::shared_ptr<detail::Counters> _engineCounters; // set by Registry
+    std::string _name;                                 // set by Registry
+    bool _checksum;
+    bool _affinity;
+    size_t _chunkSize;
+
+    size_t _getChunkSize() const
+    {
+        return _chunkSize ? _chunkSize : getChunkSize();
+    }
+    void _record(bool compress, size_t bytesIn, size_t bytesOut,
+                 const Clock::time_point& start);
+    void _decompressSingle(const uint8_t* input, size_t inputSize,
+                           uint8_t* data, size_t size);
+    bool _compressChunk(const uint8_t* data, size_t size, Result& output);
+    bool _decompressChunk(const uint8_t* input, size_t inputSize,
+                          uint8_t* data, size_t size);
 };
 
 inline size_t getDataSize(const Compressor::Results& results)
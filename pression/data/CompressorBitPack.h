@@ -0,0 +1,54 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <pression/data/Compressor.h>
+
+namespace pression
+{
+namespace data
+{
+/**
+ * Lossless compressor for arrays of integers with small deltas.
+ *
+ * The input is processed in blocks of 128 integers, distributed round-robin
+ * over the lanes of a 128 bit vector. Each value is delta-coded against the
+ * previous value in the same lane, zigzag-encoded and bit-packed using the
+ * maximum bit width of the block. Integers which do not form a complete block
+ * and trailing bytes are stored verbatim. Uses SSE2 where available, the
+ * output is identical on all platforms.
+ *
+ * @tparam T uint32_t or uint64_t, the element type of the compressed data.
+ */
+template <typename T>
+class CompressorBitPack : public Compressor
+{
+public:
+    CompressorBitPack()
+        : Compressor()
+    {
+    }
+    virtual ~CompressorBitPack() {}
+    static std::string getName();
+    size_t getCompressBound(const size_t size) const override;
+    size_t getChunkSize() const override { return LB_1MB; }
+    void compressChunk(const uint8_t* data, size_t size, Result& output) final;
+    void decompressChunk(const uint8_t* input, size_t inputSize,
+                         uint8_t* const data, size_t size) final;
+};
+}
+}
@@ -0,0 +1,252 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "CompressorFPC.h"
+
+#include <cstring>
+#include <lunchbox/buffer.h>
+#include <pression/data/Registry.h>
+
+namespace pression
+{
+namespace data
+{
+namespace
+{
+const bool _initialized =
+    Registry::getInstance().registerEngine<CompressorFPC<float>>(
+        {.78f, .25f}) &&
+    Registry::getInstance().registerEngine<CompressorFPC<double>>(
+        {.71f, .31f});
+
+const size_t _tableSize = 1 << 12; // entries per predictor hash table
+
+template <typename T>
+struct Traits;
+
+// The hash shifts are scaled from the values in the FPC paper for doubles
+template <>
+struct Traits<float>
+{
+    typedef uint32_t Int;
+    static const unsigned fcmShift = 24;
+    static const unsigned dfcmShift = 20;
+
+    // leading zero byte counts 0..4 map directly to the three bit code
+    static unsigned encode(const unsigned zeroBytes) { return zeroBytes; }
+    static unsigned decode(const unsigned code) { return code; }
+};
+
+template <>
+struct Traits<double>
+{
+    typedef uint64_t Int;
+    static const unsigned fcmShift = 48;
+    static const unsigned dfcmShift = 40;
+
+    // 0..8 leading zero bytes do not fit into three bits, treat the rare
+    // four zero bytes case as three
+    static unsigned encode(const unsigned zeroBytes)
+    {
+        return zeroBytes > 4 ? zeroBytes - 1 : zeroBytes == 4 ? 3 : zeroBytes;
+    }
+    static unsigned decode(const unsigned code)
+    {
+        return code > 3 ? code + 1 : code;
+    }
+};
+
+inline unsigned _countZeroBytes(const uint32_t value)
+{
+#ifdef __GNUC__
+    return value == 0 ? 4 : __builtin_clz(value) >> 3;
+#else
+    unsigned n = 0;
+    for (uint32_t mask = 0xff000000u; n < 4 && !(value & mask); mask >>= 8)
+        ++n;
+    return n;
+#endif
+}
+
+inline unsigned _countZeroBytes(const uint64_t value)
+{
+#ifdef __GNUC__
+    return value == 0 ? 8 : __builtin_clzll(value) >> 3;
+#else
+    const uint32_t high = uint32_t(value >> 32);
+    return high ? _countZeroBytes(high) : 4 + _countZeroBytes(uint32_t(value));
+#endif
+}
+
+/** The FCM and DFCM value predictors, one instance per chunk. */
+template <typename T>
+class Predictor
+{
+public:
+    typedef typename Traits<T>::Int Int;
+
+    Predictor()
+        : _fcm(_tableSize, 0)
+        , _dfcm(_tableSize, 0)
+        , _fcmHash(0)
+        , _dfcmHash(0)
+        , _last(0)
+    {
+    }
+
+    Int fcm() const { return _fcm[_fcmHash]; }
+    Int dfcm() const { return _dfcm[_dfcmHash] + _last; }
+    void update(const Int value)
+    {
+        const Int delta = value - _last;
+        _fcm[_fcmHash] = value;
+        _fcmHash = ((_fcmHash << 6) ^ size_t(value >> Traits<T>::fcmShift)) &
+                   (_tableSize - 1);
+        _dfcm[_dfcmHash] = delta;
+        _dfcmHash = ((_dfcmHash << 2) ^ size_t(delta >> Traits<T>::dfcmShift)) &
+                    (_tableSize - 1);
+        _last = value;
+    }
+
+private:
+    std::vector<Int> _fcm;
+    std::vector<Int> _dfcm;
+    size_t _fcmHash;
+    size_t _dfcmHash;
+    Int _last;
+};
+
+// Chunk layout: 4 bit header per value, residual bytes, unaligned tail bytes.
+// A header holds the predictor used in the MSB and the encoded number of
+// leading zero bytes of the residual in the lower three bits.
+template <typename T>
+size_t _compress(const uint8_t* const input, const size_t nValues,
+                 uint8_t* const output)
+{
+    typedef typename Traits<T>::Int Int;
+    Predictor<T> predictor;
+    uint8_t* const headers = output;
+    uint8_t* out = output + ((nValues + 1) >> 1);
+
+    for (size_t i = 0; i < nValues; ++i)
+    {
+        Int value;
+        ::memcpy(&value, input + i * sizeof(Int), sizeof(Int));
+
+        const Int fcm = value ^ predictor.fcm();
+        const Int dfcm = value ^ predictor.dfcm();
+        predictor.update(value);
+
+        const bool useDFCM = dfcm < fcm;
+        const Int residual = useDFCM ? dfcm : fcm;
+        const unsigned code = Traits<T>::encode(_countZeroBytes(residual));
+        const size_t nBytes = sizeof(Int) - Traits<T>::decode(code);
+
+        const uint8_t header = uint8_t((useDFCM ? 0x8 : 0) | code);
+        if (i & 1)
+            headers[i >> 1] |= uint8_t(header << 4);
+        else
+            headers[i >> 1] = header;
+
+        // little endian: low bytes first, output has one word of slack
+        ::memcpy(out, &residual, sizeof(Int));
+        out += nBytes;
+    }
+    return out - output;
+}
+
+template <typename T>
+const uint8_t* _decompress(const uint8_t* const input, const size_t inputSize,
+                           uint8_t* const output, const size_t nValues)
+{
+    typedef typename Traits<T>::Int Int;
+    Predictor<T> predictor;
+    const uint8_t* const headers = input;
+    const uint8_t* in = input + ((nValues + 1) >> 1);
+    const uint8_t* const safeEnd =
+        inputSize >= sizeof(Int) ? input + inputSize - sizeof(Int) : input;
+
+    for (size_t i = 0; i < nValues; ++i)
+    {
+        const uint8_t header = (headers[i >> 1] >> ((i & 1) << 2)) & 0xf;
+        const size_t nBytes = sizeof(Int) - Traits<T>::decode(header & 0x7);
+
+        Int residual = 0;
+        if (in <= safeEnd) // read full word, mask unused high bytes
+        {
+            ::memcpy(&residual, in, sizeof(Int));
+            if (nBytes < sizeof(Int))
+                residual &= (Int(1) << (nBytes << 3)) - 1;
+        }
+        else
+            ::memcpy(&residual, in, nBytes);
+        in += nBytes;
+
+        const Int value =
+            residual ^ ((header & 0x8) ? predictor.dfcm() : predictor.fcm());
+        predictor.update(value);
+        ::memcpy(output + i * sizeof(Int), &value, sizeof(Int));
+    }
+    return in;
+}
+}
+
+template <typename T>
+std::string CompressorFPC<T>::getName()
+{
+    return "pression::data::CompressorFPC" + std::to_string(sizeof(T) * 8);
+}
+
+template <typename T>
+size_t CompressorFPC<T>::getCompressBound(const size_t size) const
+{
+    return size + (size / sizeof(T) + 1) / 2 + sizeof(T);
+}
+
+template <typename T>
+void CompressorFPC<T>::compressChunk(const uint8_t* const data,
+                                     const size_t size, Result& output)
+{
+    if (!_initialized)
+        return;
+
+    const size_t nValues = size / sizeof(T);
+    const size_t nBytes = nValues * sizeof(T);
+    uint8_t* const out = output.getData();
+
+    const size_t outSize = _compress<T>(data, nValues, out);
+    ::memcpy(out + outSize, data + nBytes, size - nBytes);
+    output.setSize(outSize + size - nBytes);
+}
+
+template <typename T>
+void CompressorFPC<T>::decompressChunk(const uint8_t* const input,
+                                       const size_t inputSize,
+                                       uint8_t* const data, const size_t size)
+{
+    if (!_initialized)
+        return;
+
+    const size_t nValues = size / sizeof(T);
+    const size_t nBytes = nValues * sizeof(T);
+    const uint8_t* const tail = _decompress<T>(input, inputSize, data, nValues);
+    ::memcpy(data + nBytes, tail, size - nBytes);
+}
+}
+}
+
+template class pression::data::CompressorFPC<float>;
+template class pression::data::CompressorFPC<double>;
@@ -0,0 +1,53 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <pression/data/Compressor.h>
+
+namespace pression
+{
+namespace data
+{
+/**
+ * Lossless compressor for arrays of IEEE floating point values.
+ *
+ * Each value is predicted using a finite context method (FCM) and a
+ * differential finite context method (DFCM) predictor. The better prediction
+ * is XOR'ed with the value, and only the non-zero low bytes of the residual
+ * are stored together with a four bit header per value. Trailing bytes which
+ * do not form a complete value are stored verbatim.
+ *
+ * @tparam T float or double, the element type of the compressed data.
+ */
+template <typename T>
+class CompressorFPC : public Compressor
+{
+public:
+    CompressorFPC()
+        : Compressor()
+    {
+    }
+    virtual ~CompressorFPC() {}
+    static std::string getName();
+    size_t getCompressBound(const size_t size) const override;
+    size_t getChunkSize() const override { return LB_1MB; }
+    void compressChunk(const uint8_t* data, size_t size, Result& output) final;
+    void decompressChunk(const uint8_t* input, size_t inputSize,
+                         uint8_t* const data, size_t size) final;
+};
+}
+}
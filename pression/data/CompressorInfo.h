@@ -32,13 +32,15 @@ struct CompressorInfo
     CompressorInfo()
         : ratio(1.f)
         , speed(1.f)
+        , errorBound(0.f)
         , create([] { return nullptr; })
     {
     }
 
-    CompressorInfo(const float r, const float s)
+    CompressorInfo(const float r, const float s, const float e = 0.f)
         : ratio(r)
         , speed(s)
+        , errorBound(e)
         , create([] { return nullptr; })
     {
     }
@@ -55,6 +57,7 @@ struct CompressorInfo
     std::string name; //!< Fully qualified C++ class name
     float ratio;      //!< Normalized 0..1 size after compression
     float speed;      //!< Relative speed compared to RLE compressor
+    float errorBound; //!< Maximum absolute error per value, 0 for lossless
 
     std::function<Compressor*()> create; //!< Constructor of compressor
 };
@@ -18,6 +18,7 @@
 
 #include "CompressorRLE.h"
 
+#include <cstring>
 #include <limits>
 #include <lunchbox/buffer.h>
 #include <pression/data/Registry.h>
@@ -39,17 +40,14 @@ const bool _initialized =
     Registry::getInstance().registerEngine<CompressorRLE>({.98f, 1.f});
 
 template <typename T>
-inline void _compress(const uint8_t* input, const size_t size,
-                      Compressor::Result& result)
+inline size_t _compress(const uint8_t* input, const size_t size,
+                        uint8_t* const output)
 {
     if (size == 0)
-    {
-        result.setSize(0);
-        return;
-    }
+        return 0;
 
     const T* in = reinterpret_cast<const T*>(input);
-    T* tokenOut = reinterpret_cast<T*>(result.getData());
+    T* tokenOut = reinterpret_cast<T*>(output);
     T tokenLast(in[0]);
     T tokenSame(1);
     T token(0);
@@ -61,16 +59,12 @@ inline void _compress(const uint8_t* input, const size_t size,
     }
 
     WRITE_OUTPUT(token);
-    result.setSize((tokenOut - reinterpret_cast<T*>(result.getData())) *
-                   sizeof(T));
-#ifndef PRESSION_AGGRESSIVE_CACHING
-    result.pack();
-#endif
+    return (tokenOut - reinterpret_cast<T*>(output)) * sizeof(T);
 }
 
 template <typename T>
-inline void _decompress(const uint8_t* const input, uint8_t* const output,
-                        const size_t nElems)
+inline const uint8_t* _decompress(const uint8_t* const input,
+                                  uint8_t* const output, const size_t nElems)
 {
     T token(0);
     T tokenLeft(0);
@@ -97,23 +91,30 @@ inline void _decompress(const uint8_t* const input, uint8_t* const output,
         --tokenLeft;
         out[i] = token;
     }
+    return reinterpret_cast<const uint8_t*>(in);
 }
 }
 
+// The 8-byte aligned bulk of each chunk is compressed using 64 bit tokens,
+// the remaining 0-7 bytes are appended verbatim to the output. This keeps the
+// throughput independent of the chunk size alignment.
 void CompressorRLE::compressChunk(const uint8_t* data, size_t size,
                                   Result& output)
 {
     if (!_initialized)
         return;
 
-    if ((size & 0x7) == 0)
-        _compress<uint64_t>(data, size >> 3, output);
-    else if ((size & 0x3) == 0)
-        _compress<uint32_t>(data, size >> 2, output);
-    else if ((size & 0x1) == 0)
-        _compress<uint16_t>(data, size >> 1, output);
-    else
-        _compress<uint8_t>(data, size, output);
+    const size_t nTokens = size >> 3;
+    const size_t nBytes = nTokens << 3;
+    const size_t tail = size - nBytes;
+    uint8_t* const out = output.getData();
+
+    const size_t outSize = _compress<uint64_t>(data, nTokens, out);
+    ::memcpy(out + outSize, data + nBytes, tail);
+    output.setSize(outSize + tail);
+#ifndef PRESSION_AGGRESSIVE_CACHING
+    output.pack();
+#endif
 }
 
 void CompressorRLE::decompressChunk(const uint8_t* const input, const size_t,
@@ -122,14 +123,10 @@ void CompressorRLE::decompressChunk(const uint8_t* const input, const size_t,
     if (!_initialized)
         return;
 
-    if ((size & 0x7) == 0)
-        _decompress<uint64_t>(input, data, size >> 3);
-    else if ((size & 0x3) == 0)
-        _decompress<uint32_t>(input, data, size >> 2);
-    else if ((size & 0x1) == 0)
-        _decompress<uint16_t>(input, data, size >> 1);
-    else
-        _decompress<uint8_t>(input, data, size);
+    const size_t nTokens = size >> 3;
+    const size_t nBytes = nTokens << 3;
+    const uint8_t* const tail = _decompress<uint64_t>(input, data, nTokens);
+    ::memcpy(data + nBytes, tail, size - nBytes);
 }
 }
 }
@@ -32,7 +32,8 @@ public:
     {
     }
     virtual ~CompressorRLE() {}
-    static std::string getName() { return "pression::data::CompressorRLE"; }
+    // Version 2 encodes chunks not aligned to 8 bytes differently
+    static std::string getName() { return "pression::data::CompressorRLE2"; }
     size_t getCompressBound(const size_t size) const override
     {
         return size << 1;
@@ -0,0 +1,213 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "CompressorSZ.h"
+
+#include "zstd/lib/zstd.h"
+#include <cmath>
+#include <cstring>
+#include <lunchbox/buffer.h>
+#include <pression/data/Registry.h>
+
+namespace pression
+{
+namespace data
+{
+namespace
+{
+const bool _initialized =
+    Registry::getInstance().registerEngine<CompressorSZ<float>>(
+        {.44f, .09f, 1e-3f}) &&
+    Registry::getInstance().registerEngine<CompressorSZ<double>>(
+        {.22f, .20f, 1e-3f});
+
+typedef uint16_t Code;
+const Code _escape = 0xffff;    // value stored verbatim
+const int64_t _maxCode = 32767; // zigzag( +-32767 ) < _escape
+const int _zstdLevel = 1;
+
+// Chunk layout: quantization step, size of the ZStandard-compressed codes, the
+// compressed codes (one Code per value), values stored verbatim, tail bytes.
+struct Header
+{
+    double step;
+    uint64_t codesSize;
+};
+
+inline Code _zigzag(const int64_t value)
+{
+    return Code((uint64_t(value) << 1) ^ uint64_t(value >> 63));
+}
+
+inline int64_t _unzigzag(const Code code)
+{
+    return int64_t(code >> 1) ^ -int64_t(code & 1);
+}
+
+// shared by compression and decompression to get bitwise identical results
+template <typename T>
+inline T _predict(const T last, const int64_t code, const double step)
+{
+    return T(last + double(code) * step);
+}
+
+template <typename T>
+size_t _quantize(const T* const input, const size_t nValues, const double step,
+                 Code* const codes, uint8_t* const verbatim)
+{
+    const double errorBound = step * .5;
+    uint8_t* out = verbatim;
+    T last(0);
+
+    for (size_t i = 0; i < nValues; ++i)
+    {
+        const T value = input[i];
+        if (step > 0. && std::isfinite(value))
+        {
+            const double q = std::floor((double(value) - last) / step + .5);
+            if (std::abs(q) <= double(_maxCode))
+            {
+                const T reconstructed = _predict(last, int64_t(q), step);
+                if (std::abs(double(reconstructed) - value) <= errorBound)
+                {
+                    codes[i] = _zigzag(int64_t(q));
+                    last = reconstructed;
+                    continue;
+                }
+            }
+        }
+
+        codes[i] = _escape;
+        ::memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+        last = std::isfinite(value) ? value : T(0);
+    }
+    return out - verbatim;
+}
+
+template <typename T>
+const uint8_t* _reconstruct(const Code* const codes, const size_t nValues,
+                            const double step, const uint8_t* verbatim,
+                            T* const output)
+{
+    T last(0);
+    for (size_t i = 0; i < nValues; ++i)
+    {
+        const Code code = codes[i];
+        if (code == _escape)
+        {
+            T value;
+            ::memcpy(&value, verbatim, sizeof(T));
+            verbatim += sizeof(T);
+            output[i] = value;
+            last = std::isfinite(value) ? value : T(0);
+        }
+        else
+        {
+            last = _predict(last, _unzigzag(code), step);
+            output[i] = last;
+        }
+    }
+    return verbatim;
+}
+}
+
+template <typename T>
+std::string CompressorSZ<T>::getName()
+{
+    return "pression::data::CompressorSZ" + std::to_string(sizeof(T) * 8);
+}
+
+template <typename T>
+size_t CompressorSZ<T>::getCompressBound(const size_t size) const
+{
+    return sizeof(Header) +
+           ZSTD_compressBound(size / sizeof(T) * sizeof(Code)) + size;
+}
+
+template <typename T>
+void CompressorSZ<T>::compressChunk(const uint8_t* const data,
+                                    const size_t size, Result& output)
+{
+    if (!_initialized)
+        return;
+
+    const size_t nValues = size / sizeof(T);
+    const size_t nBytes = nValues * sizeof(T);
+    std::vector<Code> codes(nValues);
+    std::vector<T> input(nValues); // aligned copy
+    ::memcpy(input.data(), data, nBytes);
+
+    Header header;
+    header.step = _errorBound > 0. ? _errorBound * 2. : 0.;
+    uint8_t* const out = output.getData();
+    uint8_t* const codesOut = out + sizeof(Header);
+    const size_t codesBound = ZSTD_compressBound(nValues * sizeof(Code));
+
+    // write verbatim values after the worst-case code area, then move down
+    uint8_t* const verbatim = codesOut + codesBound;
+    const size_t verbatimSize =
+        _quantize(input.data(), nValues, header.step, codes.data(), verbatim);
+
+    header.codesSize = ZSTD_compress(codesOut, codesBound, codes.data(),
+                                     nValues * sizeof(Code), _zstdLevel);
+    if (ZSTD_isError(header.codesSize))
+    {
+        setChunkFailed();
+        return;
+    }
+
+    ::memcpy(out, &header, sizeof(Header));
+    uint8_t* const tail = codesOut + header.codesSize;
+    ::memmove(tail, verbatim, verbatimSize);
+    ::memcpy(tail + verbatimSize, data + nBytes, size - nBytes);
+    output.setSize(tail + verbatimSize + size - nBytes - out);
+}
+
+template <typename T>
+void CompressorSZ<T>::decompressChunk(const uint8_t* const input, const size_t,
+                                      uint8_t* const data, const size_t size)
+{
+    if (!_initialized)
+        return;
+
+    const size_t nValues = size / sizeof(T);
+    const size_t nBytes = nValues * sizeof(T);
+    Header header;
+    ::memcpy(&header, input, sizeof(Header));
+
+    std::vector<Code> codes(nValues);
+    const size_t codesSize = nValues * sizeof(Code);
+    const uint8_t* const codesIn = input + sizeof(Header);
+    if (ZSTD_decompress(codes.data(), codesSize, codesIn, header.codesSize) !=
+        codesSize)
+    {
+        setChunkFailed(); // corrupt quantization codes
+        return;
+    }
+
+    std::vector<T> output(nValues); // aligned copy
+    const uint8_t* const tail =
+        _reconstruct(codes.data(), nValues, header.step,
+                     codesIn + header.codesSize, output.data());
+    ::memcpy(data, output.data(), nBytes);
+    ::memcpy(data + nBytes, tail, size - nBytes);
+}
+}
+}
+
+template class pression::data::CompressorSZ<float>;
+template class pression::data::CompressorSZ<double>;
@@ -0,0 +1,79 @@
+/* Copyright (c) 2016, Stefan Eilemann <eile@eyescale.ch>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <pression/data/Compressor.h>
+
+namespace pression
+{
+namespace data
+{
+/**
+ * Error-bounded lossy compressor for arrays of IEEE floating point values.
+ *
+ * Each value is predicted from the previously reconstructed value, and the
+ * prediction error is quantized into bins of twice the error bound. Values
+ * which cannot be quantized within the bound are stored verbatim. The
+ * quantization codes are entropy-coded using ZStandard. The decompressed data
+ * differs from the input by at most getErrorBound() per value; non-finite
+ * values and trailing bytes which do not form a complete value are retained
+ * exactly.
+ *
+ * The engines registered in the Registry use an error bound of 1e-3, which is
+ * published in CompressorInfo::errorBound. Instances created by
+ * CompressorInfo::create() can be tuned using Compressor::setErrorBound().
+ * Registry::choose() never selects lossy engines.
+ *
+ * @tparam T float or double, the element type of the compressed data.
+ */
+template <typename T>
+class CompressorSZ : public Compressor
+{
+public:
+    explicit CompressorSZ(const double errorBound = 1e-3)
+        : Compressor()
+        , _errorBound(errorBound)
+    {
+    }
+    virtual ~CompressorSZ() {}
+    static std::string getName();
+
+    /**
+     * Set the maximum absolute error per value for subsequent compressions.
+     *
+     * The bound is stored in the compressed data, the decompressor does not
+     * need to use the same setting.
+     */
+    bool setErrorBound(const double errorBound) final
+    {
+        _errorBound = errorBound;
+        return true;
+    }
+
+    /** @return the maximum absolute error per value. */
+    double getErrorBound() const { return _errorBound; }
+    size_t getCompressBound(const size_t size) const override;
+    size_t getChunkSize() const override { return LB_1MB; }
+    void compressChunk(const uint8_t* data, size_t size, Result& output) final;
+    void decompressChunk(const uint8_t* input, size_t inputSize,
+                         uint8_t* const data, size_t size) final;
+
+private:
+    double _errorBound;
+};
+}
+}
@@ -21,6 +21,8 @@
 
 #include "Compressor.h"
 
+#include <map>
+
 namespace pression
 {
 namespace data
@@ -31,6 +33,7 @@ public:
     Impl() {}
     ~Impl() {}
     CompressorInfos compressorInfos;
+    std::map<std::string, std::shared_ptr<detail::Counters>> counters;
 };
 
 Registry& Registry::getInstance()
@@ -50,7 +53,22 @@ Registry::~Registry()
 
 bool Registry::_registerEngine(const CompressorInfo& info)
 {
-    _impl->compressorInfos.push_back(info);
+    auto counters = std::make_shared<detail::Counters>();
+    const auto create = info.create;
+    const std::string name = info.name;
+
+    CompressorInfo engine = info;
+    engine.create = [create, counters, name] {
+        Compressor* compressor = create();
+        if (compressor)
+        {
+            compressor->_engineCounters = counters;
+            compressor->_name = name;
+        }
+        return compressor;
+    };
+    _impl->compressorInfos.push_back(engine);
+    _impl->counters[info.name] = counters;
     return true;
 }
 
@@ -66,6 +84,9 @@ CompressorInfo Registry::choose()
 
     for (const auto& info : _impl->compressorInfos)
     {
+        if (info.errorBound > 0.f) // lossy engines are opt-in only
+            continue;
+
         float newRating = powf(info.speed, .3f) / info.ratio;
         if (newRating > rating)
         {
@@ -76,6 +97,12 @@ CompressorInfo Registry::choose()
     return candidate;
 }
 
+Statistics Registry::getStatistics(const std::string& name) const
+{
+    const auto i = _impl->counters.find(name);
+    return i == _impl->counters.end() ? Statistics() : i->second->get();
+}
+
 CompressorInfo Registry::find(const std::string& name)
 {
     for (const auto& info : _impl->compressorInfos)
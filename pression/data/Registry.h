@@ -54,11 +54,21 @@ public:
     /** @return the information for all registered compression engines. */
     PRESSIONDATA_API const CompressorInfos& getInfos() const;
 
-    /** @return the recommended compression engine for network transmission */
+    /**
+     * @return the recommended lossless compression engine for network
+     *         transmission
+     */
     PRESSIONDATA_API CompressorInfo choose();
 
     /** @return the information on the named compression engine */
     PRESSIONDATA_API CompressorInfo find(const std::string& name);
+
+    /**
+     * @return the aggregated statistics of all compressors created by the
+     *         named compression engine, may be called concurrently to their
+     *         use.
+     */
+    PRESSIONDATA_API Statistics getStatistics(const std::string& name) const;
     //@}
 
 private:
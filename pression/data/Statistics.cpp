@@ -0,0 +1,98 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This file is part of Pression <https://github.com/Eyescale/Pression>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Statistics.h"
+
+#include <algorithm>
+
+namespace pression
+{
+namespace data
+{
+namespace detail
+{
+namespace
+{
+const auto _order = std::memory_order_relaxed;
+
+template <class O>
+void _reset(O& operation)
+{
+    operation.calls = 0;
+    operation.bytesIn = 0;
+    operation.bytesOut = 0;
+    operation.time = 0;
+    operation.maxTime = 0;
+}
+
+template <class O>
+void _get(const O& operation, Statistics::Operation& result)
+{
+    result.calls = operation.calls.load(_order);
+    result.bytesIn = operation.bytesIn.load(_order);
+    result.bytesOut = operation.bytesOut.load(_order);
+    result.time = operation.time.load(_order);
+    result.maxTime = operation.maxTime.load(_order);
+}
+}
+
+Counters::Counters()
+{
+    _reset(_compress);
+    _reset(_decompress);
+    for (auto& bin : _chunkRatios)
+        bin = 0;
+}
+
+void Counters::add(const bool compress, const uint64_t bytesIn,
+                   const uint64_t bytesOut, const uint64_t time)
+{
+    Operation& operation = compress ? _compress : _decompress;
+    operation.calls.fetch_add(1, _order);
+    operation.bytesIn.fetch_add(bytesIn, _order);
+    operation.bytesOut.fetch_add(bytesOut, _order);
+    operation.time.fetch_add(time, _order);
+
+    uint64_t maxTime = operation.maxTime.load(_order);
+    while (time > maxTime &&
+           !operation.maxTime.compare_exchange_weak(maxTime, time, _order))
+    {
+    }
+}
+
+void Counters::addChunk(const uint64_t size, const uint64_t compressedSize)
+{
+    if (size == 0)
+        return;
+    const size_t last = Statistics::nRatioBins - 1;
+    const size_t bin = std::min(size_t(compressedSize * last / size), last);
+    _chunkRatios[bin].fetch_add(1, _order);
+}
+
+Statistics Counters::get() const
+{
+    Statistics statistics;
+    _get(_compress, statistics.compress);
+    _get(_decompress, statistics.decompress);
+    for (size_t i = 0; i < Statistics::nRatioBins; ++i)
+        statistics.chunkRatios[i] = _chunkRatios[i].load(_order);
+    return statistics;
+}
+}
+}
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This file is part of Pression <https://github.com/Eyescale/Pression>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <pression/data/api.h>
+#include <pression/data/types.h>
+
+#include <atomic>
+
+namespace pression
+{
+namespace data
+{
+/** Snapshot of the usage counters of a compressor or compression engine. */
+struct Statistics
+{
+    /** Counters of compress() or decompress() operations. */
+    struct Operation
+    {
+        uint64_t calls;    //!< Number of operations
+        uint64_t bytesIn;  //!< Input bytes of all operations
+        uint64_t bytesOut; //!< Output bytes of all operations
+        uint64_t time;     //!< Cumulative operation time in nanoseconds
+        uint64_t maxTime;  //!< Longest operation time in nanoseconds
+    };
+
+    /** Bins of the chunk ratio histogram, see chunkRatios. */
+    static const size_t nRatioBins = 9;
+
+    Statistics()
+        : compress()
+        , decompress()
+        , chunkRatios()
+    {
+    }
+
+    Operation compress;   //!< Counters of compress operations
+    Operation decompress; //!< Counters of decompress operations
+
+    /**
+     * Number of compressed chunks per compression ratio.
+     *
+     * Bin i counts chunks compressed to [i/8, (i+1)/8) of their size, the last
+     * bin counts incompressible chunks.
+     */
+    uint64_t chunkRatios[nRatioBins];
+};
+
+namespace detail
+{
+/** @internal Lock-free accumulator of Statistics. */
+class Counters
+{
+public:
+    PRESSIONDATA_API Counters();
+
+    /** Account for one compress or decompress operation. */
+    PRESSIONDATA_API void add(bool compress, uint64_t bytesIn,
+                              uint64_t bytesOut, uint64_t time);
+
+    /** Account for one compressed chunk. */
+    PRESSIONDATA_API void addChunk(uint64_t size, uint64_t compressedSize);
+
+    /** @return a snapshot of the current counter values. */
+    PRESSIONDATA_API Statistics get() const;
+
+private:
+    struct Operation
+    {
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> bytesIn;
+        std::atomic<uint64_t> bytesOut;
+        std::atomic<uint64_t> time;
+        std::atomic<uint64_t> maxTime;
+    };
+
+    Operation _compress;
+    Operation _decompress;
+    std::atomic<uint64_t> _chunkRatios[Statistics::nRatioBins];
+
+    Counters(const Counters&) = delete;
+    Counters& operator=(const Counters&) = delete;
+};
+}
+}
+}
@@ -0,0 +1,191 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This file is part of Pression <https://github.com/Eyescale/Pression>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Trace.h"
+
+#include <lunchbox/debug.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace pression
+{
+namespace data
+{
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+struct Event
+{
+    const char* name;
+    const std::string* engine;
+    uint64_t start; // ns since the trace epoch
+    uint64_t end;
+    int thread;
+    uint64_t bytesIn;
+    uint64_t bytesOut;
+};
+
+class Recorder
+{
+public:
+    Recorder()
+        : enabled(false)
+        , epoch(Clock::now())
+    {
+    }
+
+    uint64_t now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   Clock::now() - epoch)
+            .count();
+    }
+
+    std::atomic<bool> enabled;
+    const Clock::time_point epoch;
+    std::mutex mutex;
+    std::set<std::string> engines; // event engines point into this set
+    std::vector<Event> events;
+};
+
+Recorder& _getRecorder()
+{
+    static Recorder recorder;
+    return recorder;
+}
+
+// small, stable thread identifiers for the trace viewer
+int _getThread()
+{
+    static std::atomic<int> next(0);
+    thread_local const int thread = next++;
+    return thread;
+}
+
+void _write(std::ostream& os, const uint64_t time)
+{
+    os << time / 1000 << '.' << std::setw(3) << std::setfill('0')
+       << time % 1000;
+}
+}
+
+bool Trace::isSupported()
+{
+#ifdef PRESSION_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Trace::setEnabled(const bool enable)
+{
+    _getRecorder().enabled = enable;
+}
+
+bool Trace::isEnabled()
+{
+    return _getRecorder().enabled;
+}
+
+void Trace::clear()
+{
+    Recorder& recorder = _getRecorder();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    recorder.events.clear();
+}
+
+size_t Trace::getSize()
+{
+    Recorder& recorder = _getRecorder();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    return recorder.events.size();
+}
+
+void Trace::write(std::ostream& os)
+{
+    Recorder& recorder = _getRecorder();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+
+    // complete ("X") events with microsecond timestamps
+    os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    for (size_t i = 0; i < recorder.events.size(); ++i)
+    {
+        const Event& event = recorder.events[i];
+        os << (i == 0 ? "" : ",") << std::endl
+           << "  {\"name\": \"" << event.name << "\", \"cat\": \""
+           << *event.engine << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+           << event.thread << ", \"ts\": ";
+        _write(os, event.start);
+        os << ", \"dur\": ";
+        _write(os, event.end - event.start);
+        os << ", \"args\": {\"bytesIn\": " << event.bytesIn
+           << ", \"bytesOut\": " << event.bytesOut << "}}";
+    }
+    os << std::endl << "]}" << std::endl;
+}
+
+void Trace::write(const std::string& filename)
+{
+    std::ofstream file(filename);
+    write(file);
+    file.close();
+    if (!file)
+        LBTHROW(std::runtime_error("Can't write trace to " + filename));
+}
+
+namespace detail
+{
+TraceSpan::TraceSpan(const char* name, const std::string& engine,
+                     const uint64_t bytesIn, const uint64_t bytesOut)
+    : _name(name)
+    , _engine(engine)
+    , _bytesIn(bytesIn)
+    , _bytesOut(bytesOut)
+    , _start(0)
+    , _enabled(Trace::isEnabled())
+{
+    if (_enabled)
+        _start = _getRecorder().now();
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (!_enabled)
+        return;
+
+    Recorder& recorder = _getRecorder();
+    const uint64_t end = recorder.now();
+    const int thread = _getThread();
+
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    const std::string* engine = &*recorder.engines.insert(_engine).first;
+    recorder.events.push_back(
+        {_name, engine, _start, end, thread, _bytesIn, _bytesOut});
+}
+}
+}
+}
@@ -0,0 +1,94 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This file is part of Pression <https://github.com/Eyescale/Pression>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <pression/data/api.h>
+#include <pression/data/types.h>
+
+#include <iosfwd>
+#include <string>
+
+namespace pression
+{
+namespace data
+{
+/**
+ * Per-chunk trace of all compressors, in the Chrome trace event format.
+ *
+ * Each compress and decompress operation and each chunk processed by it is
+ * recorded with its start and end time, thread, engine, input and output
+ * size. The result can be loaded in chrome://tracing or ui.perfetto.dev.
+ *
+ * Events are only recorded if the library is built with the PRESSION_TRACE
+ * CMake option. Otherwise the tracing hooks compile to nothing and the trace
+ * stays empty.
+ */
+class Trace
+{
+public:
+    /** @return true if the library was built with tracing support. */
+    PRESSIONDATA_API static bool isSupported();
+
+    /** Enable or disable recording of new events. Disabled by default. */
+    PRESSIONDATA_API static void setEnabled(bool enable);
+
+    /** @return true if new events are recorded. */
+    PRESSIONDATA_API static bool isEnabled();
+
+    /** Discard all recorded events. */
+    PRESSIONDATA_API static void clear();
+
+    /** @return the number of recorded events. */
+    PRESSIONDATA_API static size_t getSize();
+
+    /** Write all recorded events as Chrome trace JSON. */
+    PRESSIONDATA_API static void write(std::ostream& os);
+
+    /**
+     * Write all recorded events as Chrome trace JSON to the given file.
+     * @throw std::runtime_error if the file can't be written
+     */
+    PRESSIONDATA_API static void write(const std::string& filename);
+};
+
+namespace detail
+{
+/** @internal Records the lifetime of an instance as one trace event. */
+class TraceSpan
+{
+public:
+    PRESSIONDATA_API TraceSpan(const char* name, const std::string& engine,
+                               uint64_t bytesIn, uint64_t bytesOut = 0);
+    PRESSIONDATA_API ~TraceSpan();
+
+    void setBytesOut(const uint64_t bytesOut) { _bytesOut = bytesOut; }
+private:
+    const char* const _name;
+    const std::string& _engine;
+    const uint64_t _bytesIn;
+    uint64_t _bytesOut;
+    uint64_t _start;
+    bool _enabled;
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+}
+}
+}
@@ -23,7 +23,7 @@
 namespace pression
 {
 /**
- * Lossless byte compression plugin API.
+ * Byte compression plugin API.
  *
  * Custom compressors inherit the Compressor API, either overriding the public
  * compress and decompress methods (if the used algorithm is parallel), or the
@@ -33,12 +33,17 @@ namespace pression
  * an example implementation.
  *
  * Provided with pression are a very low overhead RLE compressor, two LZ
- * variants, Snappy and ZStandard compression plugins.
+ * variants, Snappy and ZStandard compression plugins, as well as a predictive
+ * compressor for floating point arrays and a bit-packing compressor for integer
+ * index and identifier arrays. CompressorSZ is an opt-in, lossy
+ * compressor for floating point arrays with a guaranteed absolute error bound.
  */
 namespace data
 {
+class Archive;
 class Compressor;
 struct CompressorInfo;
+struct Statistics;
 
 typedef std::vector<CompressorInfo> CompressorInfos;
 }
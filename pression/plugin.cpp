@@ -58,6 +58,8 @@ Plugin::Plugin(const std::string& libraryName)
     , getNumResults(
           getFunctionPointer<GetNumResults_t>("EqCompressorGetNumResults"))
     , getResult(getFunctionPointer<GetResult_t>("EqCompressorGetResult"))
+    , setParameter(
+          getFunctionPointer<SetParameter_t>("EqCompressorSetParameter"))
     , isCompatible(
           getFunctionPointer<IsCompatible_t>("EqCompressorIsCompatible"))
     , download(getFunctionPointer<Download_t>("EqCompressorDownload"))
@@ -64,6 +64,8 @@ public:
                                  const void* const*, const uint64_t* const,
                                  const unsigned, void* const, uint64_t* const,
                                  const uint64_t);
+    typedef bool (*SetParameter_t)(void* const, const unsigned,
+                                   const unsigned, const uint64_t);
     typedef bool (*IsCompatible_t)(const unsigned, const GLEWContext*);
     typedef void (*Download_t)(void* const, const unsigned, const GLEWContext*,
                                const uint64_t*, const unsigned, const uint64_t,
@@ -129,6 +131,9 @@ public:
     /** Get the nth result from the last compression. @version 1.7.1 */
     GetResult_t const getResult;
 
+    /** Set a compression parameter, may be 0. @version 2.1 */
+    SetParameter_t const setParameter;
+
     /** Check if the transfer plugin can be used. @version 1.7.1 */
     IsCompatible_t const isCompatible;
 
@@ -190,7 +190,7 @@ typedef unsigned long long eq_uint64_t;
 /** @name Compressor Plugin API Versioning */
 /*@{*/
 /** The version of the Compressor API described by this header. */
-#define EQ_COMPRESSOR_VERSION 4
+#define EQ_COMPRESSOR_VERSION 5
 /** At least version 1 of the Compressor API is described by this header. */
 #define EQ_COMPRESSOR_VERSION_1 1
 /**At least version 2 of the Compressor API is described by this header.*/
@@ -199,6 +199,8 @@ typedef unsigned long long eq_uint64_t;
 #define EQ_COMPRESSOR_VERSION_3 1
 /**At least version 4 of the Compressor API is described by this header.*/
 #define EQ_COMPRESSOR_VERSION_4 1
+/**At least version 5 of the Compressor API is described by this header.*/
+#define EQ_COMPRESSOR_VERSION_5 1
 /*@}*/
 
 #include "compressorTokens.h"
@@ -310,6 +312,40 @@ extern "C" {
      */
 #define EQ_COMPRESSOR_USE_ASYNC_UPLOAD 0x200
 #endif
+
+/**
+ * Capability to change compression parameters at runtime.
+ * If set, the compressor accepts parameters using EqCompressorSetParameter().
+ * @version 5
+ */
+#define EQ_COMPRESSOR_PARAMETERS 0x400
+/*@}*/
+
+/**
+ * @name Compressor parameters
+ *
+ * Parameters change how a compressor instance compresses subsequent data, see
+ * EqCompressorSetParameter(). The decompressor does not need them.
+ */
+/*@{*/
+/** The lossy compression quality, from 1 (lowest) to 100. @version 5 */
+#define EQ_COMPRESSOR_PARAMETER_QUALITY 1
+/** The chroma subsampling, one of EQ_COMPRESSOR_SUBSAMPLING_*. @version 5 */
+#define EQ_COMPRESSOR_PARAMETER_SUBSAMPLING 2
+/**
+ * The compressed size in bytes to aim for, 0 to disable.
+ * The compressor adjusts its quality after each compression to approach this
+ * size with the next one.
+ * @version 5
+ */
+#define EQ_COMPRESSOR_PARAMETER_TARGET_SIZE 3
+
+/** Full resolution chroma. @version 5 */
+#define EQ_COMPRESSOR_SUBSAMPLING_444 0
+/** Half horizontal chroma resolution. @version 5 */
+#define EQ_COMPRESSOR_SUBSAMPLING_422 1
+/** Half horizontal and vertical chroma resolution. @version 5 */
+#define EQ_COMPRESSOR_SUBSAMPLING_420 2
 /*@}*/
 
 /** @name DSO information interface. */
@@ -524,6 +560,25 @@ EQ_PLUGIN_API void EqCompressorDecompress(
     void* const decompressor, const unsigned name, const void* const* in,
     const eq_uint64_t* const inSizes, const unsigned numInputs, void* const out,
     eq_uint64_t* const outDims, const eq_uint64_t flags);
+
+/**
+ * Set a parameter used by the following compressions of an instance.
+ *
+ * Only compressors with the EQ_COMPRESSOR_PARAMETERS capability accept
+ * parameters. The parameters of a new instance have default values.
+ *
+ * @param compressor the compressor instance.
+ * @param name the type name of the compressor.
+ * @param parameter the parameter to set, one of EQ_COMPRESSOR_PARAMETER_*.
+ * @param value the new value of the parameter.
+ * @return true if the parameter was set, false if the parameter or value is
+ *         not supported by the compressor.
+ * @version 5
+ */
+EQ_PLUGIN_API bool EqCompressorSetParameter(void* const compressor,
+                                            const unsigned name,
+                                            const unsigned parameter,
+                                            const eq_uint64_t value);
 /*@}*/
 
 /** @name Transfer engine worker functions */
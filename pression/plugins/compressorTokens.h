@@ -111,6 +111,9 @@
 /** Data is processed in three interleaved streams of BGR float color tokens. */
 #define EQ_COMPRESSOR_DATATYPE_BGR32F 0x404
 
+/** Data is processed in one stream of float tokens. */
+#define EQ_COMPRESSOR_DATATYPE_R32F 0x822e
+
 /**
  * Data is processed in four interleaved streams of YUVA components.
  * Special image format reducing color sampling.
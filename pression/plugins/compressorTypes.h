@@ -91,6 +91,52 @@
 #define EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT 0x27u
 /** RLE compression of unsigned tokens. */
 #define EQ_COMPRESSOR_RLE_DIFF_UNSIGNED 0x28u
+/** Tiled RLE compression of RGBA byte tokens. */
+#define EQ_COMPRESSOR_RLE_TILE_RGBA 0x29u
+/** Tiled RLE compression of BGRA byte tokens. */
+#define EQ_COMPRESSOR_RLE_TILE_BGRA 0x2au
+/** Tiled differential RLE compression of RGBA byte tokens. */
+#define EQ_COMPRESSOR_RLE_TILE_DIFF_RGBA 0x2bu
+/** Tiled differential RLE compression of BGRA byte tokens. */
+#define EQ_COMPRESSOR_RLE_TILE_DIFF_BGRA 0x2cu
+/** RLE compression of RGBA byte tokens relative to the previous frame. */
+#define EQ_COMPRESSOR_RLE_DELTA_RGBA 0x2du
+/** RLE compression of BGRA byte tokens relative to the previous frame. */
+#define EQ_COMPRESSOR_RLE_DELTA_BGRA 0x2eu
+/** RLE compression of the RGBA byte tiles changed since the previous frame. */
+#define EQ_COMPRESSOR_RLE_DIRTY_RGBA 0x2fu
+/** RLE compression of the BGRA byte tiles changed since the previous frame. */
+#define EQ_COMPRESSOR_RLE_DIRTY_BGRA 0x30u
+/** Lossless predictive compression of RGBA byte tokens. */
+#define EQ_COMPRESSOR_LOCO_RGBA 0x31u
+/** Lossless predictive compression of BGRA byte tokens. */
+#define EQ_COMPRESSOR_LOCO_BGRA 0x32u
+/** Lossless predictive compression of RGB byte tokens. */
+#define EQ_COMPRESSOR_LOCO_RGB 0x33u
+/** Lossless predictive compression of BGR byte tokens. */
+#define EQ_COMPRESSOR_LOCO_BGR 0x34u
+/** Single pass lossless compression of RGBA byte tokens. */
+#define EQ_COMPRESSOR_QOI_RGBA 0x35u
+/** Single pass lossless compression of BGRA byte tokens. */
+#define EQ_COMPRESSOR_QOI_BGRA 0x36u
+/** RLE compression of YCoCg-R transformed RGBA byte tokens. */
+#define EQ_COMPRESSOR_RLE_YCOCG_RGBA 0x37u
+/** RLE compression of YCoCg-R transformed BGRA byte tokens. */
+#define EQ_COMPRESSOR_RLE_YCOCG_BGRA 0x38u
+/** Lossless predictive compression of depth unsigned int tokens. */
+#define EQ_COMPRESSOR_PREDICT_DEPTH_UNSIGNED_INT 0x39u
+/** RLE compression of RGBA float tokens. */
+#define EQ_COMPRESSOR_RLE_RGBA32F 0x3au
+/** RLE compression of BGRA float tokens. */
+#define EQ_COMPRESSOR_RLE_BGRA32F 0x3bu
+/** Differential RLE compression of RGBA float tokens. */
+#define EQ_COMPRESSOR_RLE_DIFF_RGBA32F 0x3cu
+/** Differential RLE compression of BGRA float tokens. */
+#define EQ_COMPRESSOR_RLE_DIFF_BGRA32F 0x3du
+/** RLE compression of single channel float tokens. */
+#define EQ_COMPRESSOR_RLE_R32F 0x3eu
+/** Differential RLE compression of single channel float tokens. */
+#define EQ_COMPRESSOR_RLE_DIFF_R32F 0x3fu
 
 // Equalizer GPU<->CPU transfer plugins
 /* Transfer data from internal RGBA to external RGBA format with a data type
@@ -225,6 +271,38 @@
 #define EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGR90 0x20000au
 /** Eyescale 80% quality CPU jpeg BGR compressor */
 #define EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGR80 0x20000bu
+/** Eyescale quasi-lossless CPU jpeg RGBA compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA100 0x20000cu
+/** Eyescale 90% quality CPU jpeg RGBA compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA90 0x20000du
+/** Eyescale 80% quality CPU jpeg RGBA compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA80 0x20000eu
+/** Eyescale quasi-lossless CPU jpeg BGRA compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGRA100 0x20000fu
+/** Eyescale 90% quality CPU jpeg BGRA compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGRA90 0x200010u
+/** Eyescale 80% quality CPU jpeg BGRA compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGRA80 0x200011u
+/** Eyescale quasi-lossless CPU jpeg RGB compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGB100 0x200012u
+/** Eyescale 90% quality CPU jpeg RGB compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGB90 0x200013u
+/** Eyescale 80% quality CPU jpeg RGB compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGB80 0x200014u
+/** Eyescale quasi-lossless CPU jpeg BGR compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR100 0x200015u
+/** Eyescale 90% quality CPU jpeg BGR compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR90 0x200016u
+/** Eyescale 80% quality CPU jpeg BGR compressor in parallel stripes */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR80 0x200017u
+/** Eyescale CPU jpeg RGBA compressor with runtime parameters */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_RGBA 0x200018u
+/** Eyescale CPU jpeg BGRA compressor with runtime parameters */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_BGRA 0x200019u
+/** Eyescale CPU jpeg RGB compressor with runtime parameters */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_RGB 0x20001au
+/** Eyescale CPU jpeg BGR compressor with runtime parameters */
+#define EQ_COMPRESSOR_CH_EYESCALE_JPEG_TUNABLE_BGR 0x20001bu
 
 /**
  * Private types -FOR DEVELOPMENT ONLY-.
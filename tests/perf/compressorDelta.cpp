@@ -0,0 +1,142 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Streams an animated sequence through the RLE and the delta RLE engines, and
+// checks that decompressors joining late or missing a frame resynchronize at
+// the next keyframe. Round trips images and 1D buffers of odd sizes.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+#include <algorithm>
+
+namespace
+{
+const eq_uint64_t _frameSize = 512; // width and height of corpus frames
+const size_t _nFrames = 64;         // covers a keyframe after the first
+const size_t _lateFrame = 10;       // first frame of the late decompressor
+const size_t _lostFrame = 20;       // frame missed by the lossy decompressor
+const size_t _keyFrame = 60;        // first keyframe after _lateFrame
+
+struct Stream
+{
+    explicit Stream(const unsigned name_)
+        : name(name_)
+        , compressor(EqCompressorNewCompressor(name))
+        , decompressor(EqCompressorNewDecompressor(name))
+        , late(EqCompressorNewDecompressor(name))
+        , lossy(EqCompressorNewDecompressor(name))
+        , size(0)
+        , compressTime(0.f)
+        , decompressTime(0.f)
+    {
+    }
+
+    ~Stream()
+    {
+        EqCompressorDeleteCompressor(compressor);
+        EqCompressorDeleteDecompressor(decompressor);
+        EqCompressorDeleteDecompressor(late);
+        EqCompressorDeleteDecompressor(lossy);
+    }
+
+    const unsigned name;
+    void* const compressor;
+    void* const decompressor;
+    void* const late;
+    void* const lossy;
+    eq_uint64_t size;
+    float compressTime;
+    float decompressTime;
+};
+
+void _testFrame(Stream& stream, const uint8_t* frame, const size_t index)
+{
+    eq_uint64_t dims[4] = {0, _frameSize, 0, _frameSize};
+    const plugin::Compressed compressed =
+        plugin::compress(stream.compressor, stream.name, frame, dims,
+                         EQ_COMPRESSOR_DATA_2D);
+    stream.compressTime += compressed.time;
+    stream.size += compressed.size;
+
+    const size_t size = _frameSize * _frameSize * 4;
+    std::vector<uint8_t> result(size);
+    stream.decompressTime +=
+        plugin::decompress(stream.decompressor, stream.name, compressed,
+                           result.data(), dims, EQ_COMPRESSOR_DATA_2D);
+    TESTINFO(::memcmp(result.data(), frame, size) == 0,
+             "0x" << std::hex << stream.name << std::dec << " frame "
+                  << index);
+
+    const bool synced =
+        index >= _keyFrame || stream.name != EQ_COMPRESSOR_RLE_DELTA_RGBA;
+    if (index >= _lateFrame)
+    {
+        plugin::decompress(stream.late, stream.name, compressed, result.data(),
+                           dims, EQ_COMPRESSOR_DATA_2D);
+        if (synced)
+        {
+            TESTINFO(::memcmp(result.data(), frame, size) == 0,
+                     "0x" << std::hex << stream.name << std::dec
+                          << " late decompressor frame " << index);
+        }
+        else // no reference frame yet, output is cleared
+        {
+            TESTINFO(size_t(std::count(result.begin(), result.end(), 0)) ==
+                         size,
+                     "0x" << std::hex << stream.name << std::dec
+                          << " late decompressor frame " << index);
+        }
+    }
+
+    if (index == _lostFrame)
+        return;
+    plugin::decompress(stream.lossy, stream.name, compressed, result.data(),
+                       dims, EQ_COMPRESSOR_DATA_2D);
+    if (synced || index < _lostFrame)
+        TESTINFO(::memcmp(result.data(), frame, size) == 0,
+                 "0x" << std::hex << stream.name << std::dec
+                      << " lossy decompressor frame " << index);
+}
+}
+
+int main(int, char**)
+{
+    const size_t frameBytes = _frameSize * _frameSize * 4;
+    const corpus::Data frames =
+        corpus::generate("rgba", frameBytes * _nFrames);
+
+    Stream rle(EQ_COMPRESSOR_RLE_RGBA);
+    Stream delta(EQ_COMPRESSOR_RLE_DELTA_RGBA);
+    Stream* streams[] = {&rle, &delta};
+    for (size_t i = 0; i < _nFrames; ++i)
+        for (Stream* stream : streams)
+            _testFrame(*stream, &frames[i * frameBytes], i);
+
+    for (const Stream* stream : streams)
+        std::cout << "0x" << std::hex << stream->name << std::dec << ": ratio "
+                  << float(stream->size) / float(frames.size()) << ", "
+                  << stream->compressTime / _nFrames << " ms compress, "
+                  << stream->decompressTime / _nFrames
+                  << " ms decompress per frame" << std::endl;
+
+    const std::vector<uint8_t> image(frames.begin(), frames.end());
+    plugin::testOddSizes(EQ_COMPRESSOR_RLE_DELTA_RGBA, image, 4);
+    return EXIT_SUCCESS;
+}
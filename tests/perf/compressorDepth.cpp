@@ -0,0 +1,101 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compresses rendered depth buffers with the predictive depth engine and the
+// RLE engine, and checks that the depth engine is lossless and compresses
+// better. Round trips images and 1D buffers of odd sizes.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+namespace
+{
+const eq_uint64_t _frameSize = 512; // width and height of corpus frames
+const size_t _nFrames = 8;
+const eq_uint64_t _width = 1920;
+const eq_uint64_t _height = 1080;
+
+// Rasterizes overlapping, slanted rectangles over the cleared far plane
+std::vector<uint32_t> _renderPlanes()
+{
+    corpus::Random rng(3);
+    std::vector<uint32_t> depth(_width * _height, 0xffffffffu);
+    for (size_t i = 0; i < 64; ++i)
+    {
+        const eq_uint64_t x0 = rng.get(_width);
+        const eq_uint64_t y0 = rng.get(_height);
+        const eq_uint64_t x1 = std::min(x0 + 1 + rng.get(_width / 4), _width);
+        const eq_uint64_t y1 =
+            std::min(y0 + 1 + rng.get(_height / 4), _height);
+        const int64_t z = int64_t(rng.get(1u << 30)) << 1;
+        const int64_t dx = rng.getSigned(1 << 16);
+        const int64_t dy = rng.getSigned(1 << 16);
+        for (eq_uint64_t y = y0; y < y1; ++y)
+            for (eq_uint64_t x = x0; x < x1; ++x)
+            {
+                const uint32_t value = uint32_t(z + dx * x + dy * y);
+                uint32_t& pixel = depth[y * _width + x];
+                pixel = std::min(pixel, value);
+            }
+    }
+    return depth;
+}
+
+// @return the compression ratio of the depth buffer
+float _testEngine(const unsigned name, const std::vector<uint32_t>& depth,
+                  const eq_uint64_t width, const eq_uint64_t height)
+{
+    std::vector<uint32_t> result;
+    const plugin::Result stats = plugin::roundTrip(name, depth, result, width,
+                                                   height,
+                                                   EQ_COMPRESSOR_DATA_2D);
+    for (size_t i = 0; i < depth.size(); ++i)
+        TESTINFO(result[i] == depth[i], "0x" << std::hex << name << std::dec
+                                             << " value " << i);
+
+    const std::string size =
+        " " + std::to_string(width) + "x" + std::to_string(height);
+    plugin::print(name, size, stats, depth.size() * sizeof(uint32_t));
+    return stats.ratio;
+}
+
+void _testEngines(const std::vector<uint32_t>& depth, const eq_uint64_t width,
+                  const eq_uint64_t height)
+{
+    const float rle = _testEngine(EQ_COMPRESSOR_RLE_DEPTH_UNSIGNED_INT, depth,
+                                  width, height);
+    const float predict = _testEngine(EQ_COMPRESSOR_PREDICT_DEPTH_UNSIGNED_INT,
+                                      depth, width, height);
+    TESTINFO(predict < rle, predict << " >= " << rle);
+}
+}
+
+int main(int, char**)
+{
+    const size_t size = _frameSize * _frameSize * _nFrames;
+    const corpus::Data frames = corpus::generate("depth", size * 4);
+    std::vector<uint32_t> spheres(size);
+    ::memcpy(spheres.data(), frames.data(), size * 4);
+
+    _testEngines(spheres, _frameSize, _frameSize * _nFrames);
+    const std::vector<uint32_t> planes = _renderPlanes();
+    _testEngines(planes, _width, _height);
+    plugin::testOddSizes(EQ_COMPRESSOR_PREDICT_DEPTH_UNSIGNED_INT, planes, 1);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Streams a mostly static sequence, where only a small box moves over a
+// rendered background, through the RLE, delta and dirty tile RLE engines.
+// Checks that decompressors joining late or missing a frame resynchronize at
+// the next keyframe. Round trips images and 1D buffers of odd sizes.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+namespace
+{
+const eq_uint64_t _width = 1920;
+const eq_uint64_t _height = 1080;
+const eq_uint64_t _boxSize = 64;
+const size_t _nFrames = 64;   // covers a keyframe after the first
+const size_t _lateFrame = 10; // first frame of the late decompressor
+const size_t _lostFrame = 20; // frame missed by the lossy decompressor
+const size_t _keyFrame = 60;  // first keyframe after _lateFrame
+
+// Draws the box of the given frame over the background
+void _drawFrame(const std::vector<uint32_t>& background, const size_t index,
+                std::vector<uint32_t>& frame)
+{
+    frame = background;
+    const eq_uint64_t x0 = index * 23 % (_width - _boxSize);
+    const eq_uint64_t y0 = index * 11 % (_height - _boxSize);
+    for (eq_uint64_t y = y0; y < y0 + _boxSize; ++y)
+        for (eq_uint64_t x = x0; x < x0 + _boxSize; ++x)
+            frame[y * _width + x] = 0xff000000u | uint32_t(index * 0x030507);
+}
+
+struct Stream
+{
+    explicit Stream(const unsigned name_)
+        : name(name_)
+        , compressor(EqCompressorNewCompressor(name))
+        , decompressor(EqCompressorNewDecompressor(name))
+        , late(EqCompressorNewDecompressor(name))
+        , lossy(EqCompressorNewDecompressor(name))
+        , size(0)
+        , compressTime(0.f)
+        , decompressTime(0.f)
+    {
+    }
+
+    ~Stream()
+    {
+        EqCompressorDeleteCompressor(compressor);
+        EqCompressorDeleteDecompressor(decompressor);
+        EqCompressorDeleteDecompressor(late);
+        EqCompressorDeleteDecompressor(lossy);
+    }
+
+    const unsigned name;
+    void* const compressor;
+    void* const decompressor;
+    void* const late;
+    void* const lossy;
+    eq_uint64_t size;
+    float compressTime;
+    float decompressTime;
+};
+
+void _testFrame(Stream& stream, const std::vector<uint32_t>& frame,
+                const size_t index)
+{
+    eq_uint64_t dims[4] = {0, _width, 0, _height};
+    const plugin::Compressed compressed =
+        plugin::compress(stream.compressor, stream.name, frame.data(), dims,
+                         EQ_COMPRESSOR_DATA_2D);
+    stream.compressTime += compressed.time;
+    stream.size += compressed.size;
+
+    std::vector<uint32_t> result(frame.size());
+    stream.decompressTime +=
+        plugin::decompress(stream.decompressor, stream.name, compressed,
+                           result.data(), dims, EQ_COMPRESSOR_DATA_2D);
+    TESTINFO(result == frame,
+             "0x" << std::hex << stream.name << std::dec << " frame "
+                  << index);
+
+    const bool synced = index >= _keyFrame ||
+                        stream.name == EQ_COMPRESSOR_RLE_RGBA;
+    if (index >= _lateFrame)
+    {
+        plugin::decompress(stream.late, stream.name, compressed, result.data(),
+                           dims, EQ_COMPRESSOR_DATA_2D);
+        if (synced)
+            TESTINFO(result == frame, "0x" << std::hex << stream.name
+                                           << std::dec
+                                           << " late decompressor frame "
+                                           << index);
+    }
+
+    if (index == _lostFrame)
+        return;
+    plugin::decompress(stream.lossy, stream.name, compressed, result.data(),
+                       dims, EQ_COMPRESSOR_DATA_2D);
+    if (synced || index < _lostFrame)
+        TESTINFO(result == frame, "0x" << std::hex << stream.name << std::dec
+                                       << " lossy decompressor frame "
+                                       << index);
+}
+}
+
+int main(int, char**)
+{
+    const corpus::Data data = corpus::generate("rgba", _width * _height * 4);
+    std::vector<uint32_t> background(_width * _height);
+    ::memcpy(background.data(), data.data(), data.size());
+
+    Stream rle(EQ_COMPRESSOR_RLE_RGBA);
+    Stream delta(EQ_COMPRESSOR_RLE_DELTA_RGBA);
+    Stream dirty(EQ_COMPRESSOR_RLE_DIRTY_RGBA);
+    Stream* streams[] = {&rle, &delta, &dirty};
+    std::vector<uint32_t> frame;
+    for (size_t i = 0; i < _nFrames; ++i)
+    {
+        _drawFrame(background, i, frame);
+        for (Stream* stream : streams)
+            _testFrame(*stream, frame, i);
+    }
+
+    const float size = float(_nFrames * _width * _height * 4);
+    for (const Stream* stream : streams)
+        std::cout << "0x" << std::hex << stream->name << std::dec << ": ratio "
+                  << float(stream->size) / size << ", "
+                  << stream->compressTime / _nFrames << " ms compress, "
+                  << stream->decompressTime / _nFrames
+                  << " ms decompress per frame" << std::endl;
+
+    // only two keyframes compress the whole background
+    TEST(dirty.size * 10 < rle.size);
+
+    plugin::testOddSizes(EQ_COMPRESSOR_RLE_DIRTY_RGBA, background, 1);
+    return EXIT_SUCCESS;
+}
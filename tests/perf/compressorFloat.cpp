@@ -0,0 +1,86 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compresses a high dynamic range RGBA float image and single channel float
+// buffers with the float RLE engines, and checks that they are lossless and
+// that the differential RGBA engines compress better. Round trips images and
+// 1D buffers of odd sizes.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+namespace
+{
+const eq_uint64_t _width = 1920;
+const eq_uint64_t _height = 1080;
+
+// @return the compression ratio of the image with the given channels
+float _testEngine(const unsigned name, const std::vector<float>& image,
+                  const size_t nChannels)
+{
+    TESTINFO(image.size() == _width * _height * nChannels, image.size());
+    std::vector<float> result;
+    const plugin::Result stats = plugin::roundTrip(name, image, result, _width,
+                                                   _height,
+                                                   EQ_COMPRESSOR_DATA_2D);
+    TESTINFO(::memcmp(result.data(), image.data(),
+                      image.size() * sizeof(float)) == 0,
+             "0x" << std::hex << name);
+
+    plugin::print(name, "", stats, image.size() * sizeof(float));
+    return stats.ratio;
+}
+}
+
+int main(int, char**)
+{
+    // rendered image scaled to a high dynamic range with opaque float alpha
+    const corpus::Data rgba = corpus::generate("rgba", _width * _height * 4);
+    std::vector<float> image(rgba.size());
+    for (size_t i = 0; i < rgba.size(); ++i)
+        image[i] = i % 4 == 3 ? float(rgba[i]) / 255.f
+                              : float(rgba[i]) * float(rgba[i]) / 4096.f;
+
+    const float rgbaRLE = _testEngine(EQ_COMPRESSOR_RLE_RGBA32F, image, 4);
+    const float rgbaDiff =
+        _testEngine(EQ_COMPRESSOR_RLE_DIFF_RGBA32F, image, 4);
+    TESTINFO(rgbaRLE < 1.f, rgbaRLE);
+    TESTINFO(rgbaDiff < rgbaRLE, rgbaDiff << " >= " << rgbaRLE);
+    _testEngine(EQ_COMPRESSOR_RLE_BGRA32F, image, 4);
+    _testEngine(EQ_COMPRESSOR_RLE_DIFF_BGRA32F, image, 4);
+
+    // the red channel as a rendered single channel buffer, and a noisy field
+    std::vector<float> red(_width * _height);
+    for (size_t i = 0; i < red.size(); ++i)
+        red[i] = image[i * 4];
+    _testEngine(EQ_COMPRESSOR_RLE_R32F, red, 1);
+    _testEngine(EQ_COMPRESSOR_RLE_DIFF_R32F, red, 1);
+
+    const corpus::Data field =
+        corpus::generate("float", _width * _height * sizeof(float));
+    std::vector<float> values(_width * _height);
+    ::memcpy(values.data(), field.data(), values.size() * sizeof(float));
+    _testEngine(EQ_COMPRESSOR_RLE_R32F, values, 1);
+    _testEngine(EQ_COMPRESSOR_RLE_DIFF_R32F, values, 1);
+
+    plugin::testOddSizes(EQ_COMPRESSOR_RLE_DIFF_RGBA32F, image, 4);
+    plugin::testOddSizes(EQ_COMPRESSOR_RLE_BGRA32F, image, 4);
+    plugin::testOddSizes(EQ_COMPRESSOR_RLE_DIFF_R32F, values, 1);
+    return EXIT_SUCCESS;
+}
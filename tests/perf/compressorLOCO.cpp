@@ -0,0 +1,77 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compresses a rendered image with the predictive LOCO engines and the RLE
+// engine, and checks that the LOCO engines are lossless and compress better.
+// Round trips images and 1D buffers of odd sizes.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+namespace
+{
+const eq_uint64_t _width = 1920;
+const eq_uint64_t _height = 1080;
+
+// @return the compression ratio of the image with the given pixel size
+float _testEngine(const unsigned name, const std::vector<uint8_t>& image,
+                  const size_t pixelSize, const eq_uint64_t flags)
+{
+    std::vector<uint8_t> result;
+    const plugin::Result stats =
+        plugin::roundTrip(name, image, result, _width, _height, flags);
+
+    const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
+    for (size_t i = 0; i < image.size(); ++i)
+        if (useAlpha || pixelSize == 3 || i % 4 != 3)
+            TESTINFO(result[i] == image[i], "0x" << std::hex << name
+                                                  << std::dec << " byte "
+                                                  << i);
+
+    plugin::print(name, useAlpha ? "" : " no alpha", stats, image.size());
+    return stats.ratio;
+}
+}
+
+int main(int, char**)
+{
+    const corpus::Data rgba = corpus::generate("rgba", _width * _height * 4);
+    const std::vector<uint8_t> image(rgba.begin(), rgba.end());
+    std::vector<uint8_t> rgb;
+    for (size_t i = 0; i < image.size(); ++i)
+        if (i % 4 != 3)
+            rgb.push_back(image[i]);
+
+    const eq_uint64_t noAlpha =
+        EQ_COMPRESSOR_DATA_2D | EQ_COMPRESSOR_IGNORE_ALPHA;
+    const float rle = _testEngine(EQ_COMPRESSOR_RLE_RGBA, image, 4,
+                                  EQ_COMPRESSOR_DATA_2D);
+    const float loco = _testEngine(EQ_COMPRESSOR_LOCO_RGBA, image, 4,
+                                   EQ_COMPRESSOR_DATA_2D);
+    TESTINFO(loco < rle, loco << " >= " << rle);
+
+    _testEngine(EQ_COMPRESSOR_LOCO_BGRA, image, 4, EQ_COMPRESSOR_DATA_2D);
+    _testEngine(EQ_COMPRESSOR_LOCO_RGBA, image, 4, noAlpha);
+    _testEngine(EQ_COMPRESSOR_LOCO_RGB, rgb, 3, EQ_COMPRESSOR_DATA_2D);
+    _testEngine(EQ_COMPRESSOR_LOCO_BGR, rgb, 3, EQ_COMPRESSOR_DATA_2D);
+
+    plugin::testOddSizes(EQ_COMPRESSOR_LOCO_RGBA, image, 4);
+    plugin::testOddSizes(EQ_COMPRESSOR_LOCO_RGB, rgb, 3);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Sets the parameters of all engines: engines without the
+// EQ_COMPRESSOR_PARAMETERS capability reject all of them, the others reject
+// out-of-range values and accept valid ones.
+
+#include <lunchbox/test.h>
+#include <pression/compressor.h>
+#include <pression/plugins/compressor.h>
+
+namespace
+{
+void _testNoParameters(void* const compressor, const unsigned name)
+{
+    for (const unsigned parameter : {EQ_COMPRESSOR_PARAMETER_QUALITY,
+                                     EQ_COMPRESSOR_PARAMETER_SUBSAMPLING,
+                                     EQ_COMPRESSOR_PARAMETER_TARGET_SIZE})
+    {
+        TESTINFO(!EqCompressorSetParameter(compressor, name, parameter, 1),
+                 "0x" << std::hex << name << std::dec << " " << parameter);
+    }
+}
+
+void _testParameters(void* const compressor, const unsigned name)
+{
+    const unsigned quality = EQ_COMPRESSOR_PARAMETER_QUALITY;
+    const unsigned subsampling = EQ_COMPRESSOR_PARAMETER_SUBSAMPLING;
+
+    TEST(EqCompressorSetParameter(compressor, name, quality, 1));
+    TEST(EqCompressorSetParameter(compressor, name, quality, 100));
+    TEST(!EqCompressorSetParameter(compressor, name, quality, 0));
+    TEST(!EqCompressorSetParameter(compressor, name, quality, 101));
+
+    TEST(EqCompressorSetParameter(compressor, name, subsampling,
+                                  EQ_COMPRESSOR_SUBSAMPLING_444));
+    TEST(EqCompressorSetParameter(compressor, name, subsampling,
+                                  EQ_COMPRESSOR_SUBSAMPLING_422));
+    TEST(EqCompressorSetParameter(compressor, name, subsampling,
+                                  EQ_COMPRESSOR_SUBSAMPLING_420));
+    TEST(!EqCompressorSetParameter(compressor, name, subsampling,
+                                   EQ_COMPRESSOR_SUBSAMPLING_420 + 1));
+
+    TEST(!EqCompressorSetParameter(compressor, name, 0, 1));
+    TEST(!EqCompressorSetParameter(compressor, name,
+                                   EQ_COMPRESSOR_PARAMETER_TARGET_SIZE + 1, 1));
+}
+}
+
+int main(int, char**)
+{
+    size_t nTunable = 0;
+    const size_t nEngines = EqCompressorGetNumCompressors();
+    for (size_t i = 0; i < nEngines; ++i)
+    {
+        EqCompressorInfo info;
+        info.version = EQ_COMPRESSOR_VERSION;
+        EqCompressorGetInfo(i, &info);
+
+        void* compressor = EqCompressorNewCompressor(info.name);
+        TESTINFO(compressor, "0x" << std::hex << info.name);
+        if (info.capabilities & EQ_COMPRESSOR_PARAMETERS)
+        {
+            _testParameters(compressor, info.name);
+            ++nTunable;
+        }
+        else
+            _testNoParameters(compressor, info.name);
+        EqCompressorDeleteCompressor(compressor);
+    }
+    std::cout << nTunable << " of " << nEngines << " engines accept parameters"
+              << std::endl;
+
+    // an uninitialized compressor has no engine to pass the parameter to
+    pression::Compressor compressor;
+    TEST(!compressor.isGood());
+    TEST(!compressor.setParameter(EQ_COMPRESSOR_PARAMETER_QUALITY, 90));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compresses rendered images with the QOI engines and the RLE4B engines, and
+// checks that the QOI engines are lossless and compress better.
+// Round trips images and 1D buffers of odd sizes.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+namespace
+{
+const eq_uint64_t _width = 1920;
+const eq_uint64_t _height = 1080;
+
+// @return the compression ratio of the image
+float _testEngine(const unsigned name, const std::vector<uint8_t>& image,
+                  const eq_uint64_t flags)
+{
+    std::vector<uint8_t> result;
+    const plugin::Result stats =
+        plugin::roundTrip(name, image, result, _width, _height, flags);
+
+    const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
+    for (size_t i = 0; i < image.size(); ++i)
+        if (useAlpha || i % 4 != 3)
+            TESTINFO(result[i] == image[i], "0x" << std::hex << name
+                                                  << std::dec << " byte "
+                                                  << i);
+
+    plugin::print(name, useAlpha ? "" : " no alpha", stats, image.size());
+    return stats.ratio;
+}
+}
+
+int main(int, char**)
+{
+    const corpus::Data rgba = corpus::generate("rgba", _width * _height * 4);
+    const std::vector<uint8_t> image(rgba.begin(), rgba.end());
+
+    const unsigned names[] = {EQ_COMPRESSOR_RLE_RGBA,
+                              EQ_COMPRESSOR_RLE_DIFF_RGBA,
+                              EQ_COMPRESSOR_QOI_RGBA, EQ_COMPRESSOR_QOI_BGRA};
+    for (const eq_uint64_t flags :
+         {eq_uint64_t(EQ_COMPRESSOR_DATA_2D),
+          eq_uint64_t(EQ_COMPRESSOR_DATA_2D | EQ_COMPRESSOR_IGNORE_ALPHA)})
+    {
+        float ratios[4];
+        for (size_t i = 0; i < 4; ++i)
+            ratios[i] = _testEngine(names[i], image, flags);
+        TESTINFO(ratios[2] < ratios[0] && ratios[2] < ratios[1],
+                 ratios[2] << " >= " << ratios[0] << ", " << ratios[1]);
+    }
+
+    plugin::testOddSizes(EQ_COMPRESSOR_QOI_RGBA, image, 4);
+    return EXIT_SUCCESS;
+}
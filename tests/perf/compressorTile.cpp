@@ -0,0 +1,115 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compresses a rendered image with the tiled RLE engines and decompresses the
+// full image and regions of interest, as needed by the tiles of a display wall.
+// Round trips images and 1D buffers which are not a multiple of the tile size.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+namespace
+{
+const eq_uint64_t _width = 1920;
+const eq_uint64_t _height = 1080;
+const eq_uint64_t _x = 1920; // position in the virtual framebuffer
+const eq_uint64_t _y = 1080;
+
+const unsigned _names[] = {EQ_COMPRESSOR_RLE_TILE_RGBA,
+                           EQ_COMPRESSOR_RLE_TILE_BGRA,
+                           EQ_COMPRESSOR_RLE_TILE_DIFF_RGBA,
+                           EQ_COMPRESSOR_RLE_TILE_DIFF_BGRA};
+
+// @return the pixels of the region (x, w, y, h) of the image
+std::vector<uint32_t> _getRegion(const std::vector<uint32_t>& image,
+                                 const eq_uint64_t* region,
+                                 const uint32_t mask)
+{
+    std::vector<uint32_t> pixels;
+    for (eq_uint64_t y = region[2] - _y; y < region[2] - _y + region[3]; ++y)
+        for (eq_uint64_t x = region[0] - _x; x < region[0] - _x + region[1];
+             ++x)
+        {
+            pixels.push_back(image[y * _width + x] & mask);
+        }
+    return pixels;
+}
+
+void _testRegion(const unsigned name, const plugin::Compressed& compressed,
+                 const std::vector<uint32_t>& image, eq_uint64_t* region,
+                 const eq_uint64_t flags)
+{
+    const uint32_t mask =
+        (flags & EQ_COMPRESSOR_IGNORE_ALPHA) ? 0xffffffu : 0xffffffffu;
+    std::vector<uint32_t> result(region[1] * region[3]);
+
+    const float time =
+        plugin::decompress(0, name, compressed, result.data(), region, flags);
+
+    TESTINFO(result == _getRegion(image, region, mask),
+             "0x" << std::hex << name << std::dec << " region " << region[0]
+                  << ", " << region[1] << ", " << region[2] << ", "
+                  << region[3]);
+    std::cout << "  " << region[1] << "x" << region[3] << " at " << region[0]
+              << ", " << region[2] << ": " << time << " ms" << std::endl;
+}
+
+void _testEngine(const unsigned name, const std::vector<uint32_t>& image,
+                 const eq_uint64_t flags)
+{
+    void* compressor = EqCompressorNewCompressor(name);
+    TESTINFO(compressor, "0x" << std::hex << name);
+
+    eq_uint64_t dims[4] = {_x, _width, _y, _height};
+    const plugin::Compressed compressed =
+        plugin::compress(compressor, name, image.data(), dims, flags);
+    std::cout << "0x" << std::hex << name << std::dec
+              << ((flags & EQ_COMPRESSOR_IGNORE_ALPHA) ? " no alpha" : "")
+              << ": " << compressed.data.size() << " results, ratio "
+              << float(compressed.size) / float(image.size() * 4) << ", "
+              << compressed.time << " ms" << std::endl;
+
+    // all, a quarter, a viewport, across tile edges and the last pixel
+    eq_uint64_t regions[][4] = {{_x, _width, _y, _height},
+                                {_x + _width / 2, _width / 2, _y, _height / 2},
+                                {_x + 100, 640, _y + 300, 360},
+                                {_x + 511, 3, _y + 31, 2},
+                                {_x + _width - 1, 1, _y + _height - 1, 1}};
+    for (eq_uint64_t* region : regions)
+        _testRegion(name, compressed, image, region, flags);
+
+    EqCompressorDeleteCompressor(compressor);
+}
+}
+
+int main(int, char**)
+{
+    const corpus::Data data = corpus::generate("rgba", _width * _height * 4);
+    std::vector<uint32_t> image(_width * _height);
+    ::memcpy(image.data(), data.data(), data.size());
+
+    for (const unsigned name : _names)
+    {
+        _testEngine(name, image, EQ_COMPRESSOR_DATA_2D);
+        _testEngine(name, image,
+                    EQ_COMPRESSOR_DATA_2D | EQ_COMPRESSOR_IGNORE_ALPHA);
+        plugin::testOddSizes(name, image, 1);
+    }
+    return EXIT_SUCCESS;
+}
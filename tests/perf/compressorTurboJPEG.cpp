@@ -0,0 +1,146 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compresses rendered images with the striped TurboJPEG engines, using heights
+// which are not a multiple of the stripe height, and checks that the striped
+// engines reproduce the image as well as the single image engines. Only built
+// if libjpeg-turbo was found.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+#include "plugin.h"
+
+#include <cmath>
+
+namespace
+{
+const eq_uint64_t _width = 1920;
+const eq_uint64_t _stripeHeight = 128;
+const eq_uint64_t _heights[] = {1, 7, 127, 129, 300, 1080};
+
+// single image and striped engine, token size and minimum PSNR in dB
+struct Engine
+{
+    unsigned name;
+    unsigned striped;
+    size_t tokenSize;
+    double minPSNR;
+};
+
+const Engine _engines[] = {{EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGBA100,
+                            EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGBA100, 4,
+                            45.},
+                           {EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGRA90,
+                            EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGRA90, 4,
+                            34.},
+                           {EQ_COMPRESSOR_CH_EYESCALE_JPEG_RGB80,
+                            EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_RGB80, 3,
+                            30.},
+                           {EQ_COMPRESSOR_CH_EYESCALE_JPEG_BGR100,
+                            EQ_COMPRESSOR_CH_EYESCALE_JPEG_STRIPED_BGR100, 3,
+                            45.}};
+
+// @return the PSNR of the color channels, checking that alpha is lossless
+double _getPSNR(const unsigned name, const std::vector<uint8_t>& image,
+                const std::vector<uint8_t>& result, const size_t tokenSize)
+{
+    double error = 0.;
+    size_t nValues = 0;
+    for (size_t i = 0; i < image.size(); ++i)
+    {
+        if (tokenSize == 4 && i % 4 == 3)
+        {
+            TESTINFO(result[i] == image[i], "0x" << std::hex << name
+                                                  << std::dec << " alpha "
+                                                  << i / 4);
+            continue;
+        }
+        const double difference = double(result[i]) - double(image[i]);
+        error += difference * difference;
+        ++nValues;
+    }
+    if (error == 0.)
+        return 100.;
+    return 10. * std::log10(255. * 255. * double(nValues) / error);
+}
+
+double _testEngine(const unsigned name, const std::vector<uint8_t>& image,
+                   const eq_uint64_t height, const size_t tokenSize)
+{
+    std::vector<uint8_t> result;
+    const plugin::Result stats = plugin::roundTrip(name, image, result, _width,
+                                                   height,
+                                                   EQ_COMPRESSOR_DATA_2D);
+    const double psnr = _getPSNR(name, image, result, tokenSize);
+
+    const std::string label = " " + std::to_string(_width) + "x" +
+                              std::to_string(height) + ", PSNR " +
+                              std::to_string(psnr) + " dB";
+    plugin::print(name, label, stats, image.size());
+    return psnr;
+}
+
+// @return the number of results of the compressed image
+unsigned _getNumResults(const unsigned name, const std::vector<uint8_t>& image,
+                        const eq_uint64_t height)
+{
+    void* compressor = EqCompressorNewCompressor(name);
+    eq_uint64_t dims[4] = {0, _width, 0, height};
+    const plugin::Compressed compressed =
+        plugin::compress(compressor, name, image.data(), dims,
+                         EQ_COMPRESSOR_DATA_2D);
+    EqCompressorDeleteCompressor(compressor);
+    return unsigned(compressed.data.size());
+}
+}
+
+int main(int, char**)
+{
+    const corpus::Data rgba = corpus::generate("rgba", _width * 1080 * 4);
+    std::vector<uint8_t> rgb;
+    for (size_t i = 0; i < rgba.size(); ++i)
+        if (i % 4 != 3)
+            rgb.push_back(rgba[i]);
+
+    for (const Engine& engine : _engines)
+    {
+        const corpus::Data& data = engine.tokenSize == 4 ? rgba : rgb;
+        for (const eq_uint64_t height : _heights)
+        {
+            const std::vector<uint8_t> image(
+                data.begin(), data.begin() + _width * height * engine.tokenSize);
+            const double psnr =
+                _testEngine(engine.name, image, height, engine.tokenSize);
+            const double stripedPSNR =
+                _testEngine(engine.striped, image, height, engine.tokenSize);
+
+            // misplaced or missing stripes would lose far more than headers
+            TESTINFO(stripedPSNR >= engine.minPSNR,
+                     stripedPSNR << " < " << engine.minPSNR);
+            TESTINFO(stripedPSNR > psnr - 1., stripedPSNR << " < " << psnr);
+
+            const eq_uint64_t nStripes =
+                (height + _stripeHeight - 1) / _stripeHeight;
+            const unsigned nAlpha = engine.tokenSize == 4 ? 1 : 0;
+            TESTINFO(_getNumResults(engine.striped, image, height) ==
+                         nStripes + nAlpha,
+                     height);
+        }
+    }
+    return EXIT_SUCCESS;
+}
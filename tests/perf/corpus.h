@@ -0,0 +1,371 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <lunchbox/types.h>
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Deterministic benchmark corpus.
+ *
+ * Generates the same bytes on every platform: all values are derived from a
+ * fixed-seed integer generator, converted to floating point exactly or with
+ * correctly rounded operations only, and stored in little endian byte order.
+ */
+namespace corpus
+{
+typedef std::vector<uint8_t> Data;
+
+/** splitmix64 generator, independent of the standard library. */
+class Random
+{
+public:
+    explicit Random(const uint64_t seed)
+        : _state(seed)
+    {
+    }
+
+    uint64_t get()
+    {
+        uint64_t z = (_state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /** @return a value in [0, range) */
+    uint32_t get(const uint32_t range)
+    {
+        return uint32_t(((get() >> 32) * range) >> 32);
+    }
+
+    /** @return a value in [-range, range] */
+    int32_t getSigned(const uint32_t range)
+    {
+        return int32_t(get(2 * range + 1)) - int32_t(range);
+    }
+
+private:
+    uint64_t _state;
+};
+
+namespace detail
+{
+const size_t _frameSize = 512; // width and height of rendered frames
+const size_t _fieldSize = 64;  // edge length of simulation frames
+const size_t _gridSize = 1024; // vertices per row of meshes
+
+// unsigned integer with the size of a value, to access its bit pattern
+template <size_t size>
+struct Bits;
+template <>
+struct Bits<1>
+{
+    typedef uint8_t type;
+};
+template <>
+struct Bits<2>
+{
+    typedef uint16_t type;
+};
+template <>
+struct Bits<4>
+{
+    typedef uint32_t type;
+};
+template <>
+struct Bits<8>
+{
+    typedef uint64_t type;
+};
+
+// append the value in little endian byte order, independent of the host
+template <typename T>
+void _append(Data& data, const T& value)
+{
+    typename Bits<sizeof(T)>::type bits;
+    ::memcpy(&bits, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i)
+        data.push_back(uint8_t(bits >> (8 * i)));
+}
+
+// smooth integer bump with period p, 0 at the ends and p * p / 4 in between
+inline int64_t _bump(const int64_t t, const int64_t p)
+{
+    const int64_t x = ((t % p) + p) % p;
+    return x * (p - x);
+}
+
+struct Sphere
+{
+    int32_t x, y, z, r;
+    int32_t dx, dy;
+    uint8_t color[3];
+};
+
+inline std::vector<Sphere> _getSpheres(Random& rng)
+{
+    std::vector<Sphere> spheres(12);
+    for (auto& sphere : spheres)
+    {
+        sphere.x = int32_t(rng.get(_frameSize));
+        sphere.y = int32_t(rng.get(_frameSize));
+        sphere.z = int32_t(rng.get(1 << 20)) + (1 << 20);
+        sphere.r = 16 + int32_t(rng.get(_frameSize / 6));
+        sphere.dx = rng.getSigned(4);
+        sphere.dy = rng.getSigned(4);
+        for (auto& channel : sphere.color)
+            channel = uint8_t(64 + rng.get(192));
+    }
+    return spheres;
+}
+
+// Renders moving, shaded spheres over a cleared background, frame by frame
+template <typename F>
+void _render(const size_t size, const uint64_t seed, F writePixel)
+{
+    Random rng(seed);
+    std::vector<Sphere> spheres = _getSpheres(rng);
+    const size_t nPixels = _frameSize * _frameSize;
+    for (size_t pixel = 0; pixel < size; ++pixel)
+    {
+        const size_t frame = pixel / nPixels;
+        const int32_t x = int32_t(pixel % _frameSize);
+        const int32_t y = int32_t((pixel / _frameSize) % _frameSize);
+        const Sphere* nearest = nullptr;
+        int32_t nearestZ = 0;
+        int32_t nearestDZ = 0;
+
+        for (const auto& sphere : spheres)
+        {
+            const int32_t dx = x - (sphere.x + sphere.dx * int32_t(frame));
+            const int32_t dy = y - (sphere.y + sphere.dy * int32_t(frame));
+            const int32_t d2 = sphere.r * sphere.r - dx * dx - dy * dy;
+            if (d2 < 0)
+                continue;
+            // IEEE sqrt is correctly rounded, hence portable
+            const int32_t dz = int32_t(std::sqrt(double(d2)));
+            const int32_t z = sphere.z - dz * 256;
+            if (!nearest || z < nearestZ)
+            {
+                nearest = &sphere;
+                nearestZ = z;
+                nearestDZ = dz;
+            }
+        }
+
+        if (nearest)
+            writePixel(nearest->color, 64 + 191 * nearestDZ / nearest->r,
+                       uint32_t(nearestZ));
+        else
+            writePixel(nullptr, 0, 0xffffffu);
+    }
+}
+
+inline void _rgba(Data& data, const size_t size)
+{
+    data.reserve(size + 4);
+    _render(size / 4 + 1, 1, [&data](const uint8_t* color, const int32_t shade,
+                                     uint32_t) {
+        if (!color) // clear color
+        {
+            const uint8_t background[] = {38, 38, 51, 0};
+            data.insert(data.end(), background, background + 4);
+            return;
+        }
+        for (size_t i = 0; i < 3; ++i)
+            data.push_back(uint8_t(color[i] * shade / 255));
+        data.push_back(255);
+    });
+}
+
+inline void _depth(Data& data, const size_t size)
+{
+    data.reserve(size + 4);
+    _render(size / 4 + 1, 1,
+            [&data](const uint8_t*, int32_t, const uint32_t depth) {
+                _append(data, depth);
+            });
+}
+
+template <typename T>
+void _field(Data& data, const size_t size)
+{
+    // smooth 3D scalar field with noise, scaled by powers of two only
+    Random rng(2);
+    const int64_t n = _fieldSize;
+    for (int64_t i = 0; data.size() < size; ++i)
+    {
+        const int64_t x = i % n;
+        const int64_t y = (i / n) % n;
+        const int64_t z = (i / n / n) % n;
+        const int64_t frame = i / n / n / n;
+        const int64_t value = _bump(x + frame, n) * _bump(y, n / 2) / 64 -
+                              _bump(z, 2 * n) * 4 + rng.getSigned(16);
+        _append(data, T(value) / T(4096));
+    }
+}
+
+inline void _vertices(Data& data, const size_t size)
+{
+    // height field on a regular grid, xyz floats
+    Random rng(3);
+    const int64_t n = _gridSize;
+    for (int64_t i = 0; data.size() < size; ++i)
+    {
+        const int64_t x = i % n;
+        const int64_t y = i / n;
+        const int64_t z = _bump(x, 256) + _bump(y, 512) / 4 + rng.getSigned(64);
+        _append(data, float(x) / 64.f);
+        _append(data, float(y) / 64.f);
+        _append(data, float(z) / 65536.f);
+    }
+}
+
+inline void _indices(Data& data, const size_t size)
+{
+    // two triangles per grid quad, row by row
+    const uint32_t n = _gridSize;
+    for (uint32_t quad = 0; data.size() < size; ++quad)
+    {
+        const uint32_t i = (quad / (n - 1)) * n + quad % (n - 1);
+        const uint32_t triangles[] = {i, i + 1, i + n, i + 1, i + n + 1, i + n};
+        for (const uint32_t index : triangles)
+            _append(data, index);
+    }
+}
+
+template <typename T>
+void _ids(Data& data, const size_t size)
+{
+    // sorted, sparse identifiers
+    Random rng(4);
+    T id = T(1) << (sizeof(T) * 4);
+    while (data.size() < size)
+    {
+        id += 1 + rng.get(16);
+        _append(data, id);
+    }
+}
+
+inline void _text(Data& data, const size_t size)
+{
+    static const char* words[] = {
+        "the",       "of",      "and",      "a",        "to",
+        "in",        "is",      "that",     "for",      "it",
+        "with",      "as",      "was",      "on",       "be",
+        "by",        "data",    "compress", "chunk",    "buffer",
+        "frame",     "pixel",   "render",   "network",  "engine",
+        "ratio",     "speed",   "parallel", "memory",   "thread",
+        "decompress", "stream", "token",    "plugin",   "result",
+        "simulation", "neuron", "mesh",     "vertex",   "index"};
+    const uint32_t nWords = sizeof(words) / sizeof(words[0]);
+    Random rng(5);
+    size_t lineLength = 0;
+    while (data.size() < size)
+    {
+        // roughly Zipf-distributed word frequencies
+        const uint32_t r = rng.get(nWords);
+        const char* word = words[r * r / nWords];
+        data.insert(data.end(), word, word + ::strlen(word));
+        lineLength += ::strlen(word) + 1;
+        if (lineLength > 72)
+        {
+            data.push_back('.');
+            data.push_back('\n');
+            lineLength = 0;
+        }
+        else
+            data.push_back(' ');
+    }
+}
+
+inline void _sparse(Data& data, const size_t size)
+{
+    // mostly zero 32 bit values with occasional short runs of values
+    Random rng(6);
+    while (data.size() < size)
+    {
+        if (rng.get(64) == 0)
+            for (uint32_t i = rng.get(8) + 1; i > 0; --i)
+                _append(data, uint32_t(rng.get()));
+        else
+            _append(data, uint32_t(0));
+    }
+}
+
+inline void _random(Data& data, const size_t size)
+{
+    Random rng(7);
+    while (data.size() < size)
+        _append(data, rng.get());
+}
+}
+
+/** @return the names of all data classes of the corpus. */
+inline std::vector<std::string> getNames()
+{
+    return {"rgba",  "depth", "float", "double", "vertex", "index",
+            "id",    "id64",  "text",  "sparse", "random"};
+}
+
+/**
+ * Generate data of the corpus.
+ *
+ * @param name the data class, see getNames()
+ * @param size the number of bytes to generate
+ * @return the same size bytes for the same name on every platform
+ * @throw std::runtime_error if the name is not a data class of the corpus
+ */
+inline Data generate(const std::string& name, const size_t size)
+{
+    Data data;
+    data.reserve(size + 16);
+    if (name == "rgba")
+        detail::_rgba(data, size);
+    else if (name == "depth")
+        detail::_depth(data, size);
+    else if (name == "float")
+        detail::_field<float>(data, size);
+    else if (name == "double")
+        detail::_field<double>(data, size);
+    else if (name == "vertex")
+        detail::_vertices(data, size);
+    else if (name == "index")
+        detail::_indices(data, size);
+    else if (name == "id")
+        detail::_ids<uint32_t>(data, size);
+    else if (name == "id64")
+        detail::_ids<uint64_t>(data, size);
+    else if (name == "text")
+        detail::_text(data, size);
+    else if (name == "sparse")
+        detail::_sparse(data, size);
+    else if (name == "random")
+        detail::_random(data, size);
+    else
+        throw std::runtime_error("Unknown corpus data class " + name);
+
+    data.resize(size);
+    return data;
+}
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+
+#include <pression/data/Archive.h>
+#include <pression/data/CompressorInfo.h>
+#include <pression/data/Registry.h>
+
+#include <lunchbox/clock.h>
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace
+{
+const std::string _filename("dataArchive.pressionarchive");
+const size_t _rangeSize = LB_1MB;
+const size_t _nRanges = 32;
+
+void _testArchive(const pression::data::CompressorInfo& info,
+                  const corpus::Data& values)
+{
+    const uint8_t* data = values.data();
+    const size_t size = values.size();
+
+    lunchbox::Clock clock;
+    pression::data::Archive::write(_filename, info, data, size);
+    const float writeTime = clock.getTimef();
+
+    pression::data::Archive archive(_filename);
+    TEST(archive.getSize() == size);
+    TEST(archive.getEngine() == info.name);
+
+    std::vector<uint8_t> result(size);
+    clock.reset();
+    archive.read(result.data(), 0, size);
+    const float readTime = clock.getTimef();
+    TEST(::memcmp(result.data(), data, size) == 0);
+
+    // unaligned ranges touching few chunks of the archive
+    corpus::Random rng(42);
+    std::vector<uint8_t> range(_rangeSize);
+    float rangeTime = 0.f;
+    for (size_t i = 0; i < _nRanges; ++i)
+    {
+        const size_t offset = rng.get() % (size - _rangeSize);
+        clock.reset();
+        archive.read(range.data(), offset, _rangeSize);
+        rangeTime += clock.getTimef();
+        TEST(::memcmp(range.data(), data + offset, _rangeSize) == 0);
+    }
+
+    try
+    {
+        archive.read(range.data(), size - 1, 2);
+        TESTINFO(false, "Read past end of archive succeeded");
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    std::cout << std::setw(20) << info.name << ", " << std::setw(10)
+              << float(size) * 1000.f / LB_1GB / writeTime << ", "
+              << std::setw(10) << float(size) * 1000.f / LB_1GB / readTime
+              << ", " << std::setw(10)
+              << float(_rangeSize * _nRanges) * 1000.f / LB_1GB / rangeTime
+              << std::endl;
+}
+}
+
+int main(int, char**)
+{
+    const corpus::Data values = corpus::generate("float", LB_10MB * 4);
+
+    std::cout << "          Compressor, write GB/s,  read GB/s, range GB/s"
+              << std::endl;
+    for (const auto& info :
+         pression::data::Registry::getInstance().getInfos())
+    {
+        if (info.errorBound == 0.f)
+            _testArchive(info, values);
+    }
+    ::remove(_filename.c_str());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,247 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Sweeps all lossless compression engines over chunk sizes, thread counts and
+// data classes, and writes throughput and ratio statistics as JSON.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+
+#include <pression/data/Compressor.h>
+#include <pression/data/CompressorInfo.h>
+#include <pression/data/Registry.h>
+
+#include <lunchbox/clock.h>
+
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <cmath>
+#include <fstream>
+#ifdef PRESSION_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace po = boost::program_options;
+
+namespace
+{
+typedef corpus::Data Data;
+
+struct Statistics
+{
+    float mean;
+    float stddev;
+};
+
+struct Result
+{
+    std::string engine;
+    std::string data;
+    size_t chunkSize;
+    int threads;
+    size_t size;
+    size_t compressedSize;
+    Statistics compress;
+    Statistics decompress;
+};
+
+Statistics _getStatistics(const size_t size, const std::vector<float>& times)
+{
+    std::vector<float> speeds;
+    for (const float time : times)
+        speeds.push_back(float(size) * 1000.f / LB_1GB /
+                         std::max(time, 1e-6f));
+
+    Statistics stats{0.f, 0.f};
+    for (const float speed : speeds)
+        stats.mean += speed;
+    stats.mean /= float(speeds.size());
+    for (const float speed : speeds)
+        stats.stddev += (speed - stats.mean) * (speed - stats.mean);
+    stats.stddev = std::sqrt(stats.stddev / float(speeds.size()));
+    return stats;
+}
+
+Result _benchmark(const pression::data::CompressorInfo& info,
+                  const std::string& dataName, const Data& data,
+                  const size_t chunkSize, const int threads,
+                  const size_t repetitions)
+{
+#ifdef PRESSION_USE_OPENMP
+    omp_set_num_threads(threads);
+#endif
+    std::unique_ptr<pression::data::Compressor> compressor(info.create());
+    compressor->setChunkSize(chunkSize);
+
+    Data result(data.size());
+    std::vector<float> compressTimes;
+    std::vector<float> decompressTimes;
+    size_t compressedSize = 0;
+
+    compressor->compress(data.data(), data.size()); // warm up
+    for (size_t i = 0; i < repetitions; ++i)
+    {
+        lunchbox::Clock clock;
+        const auto& compressed = compressor->compress(data.data(), data.size());
+        compressTimes.push_back(clock.getTimef());
+
+        clock.reset();
+        compressor->decompress(compressed, result.data(), result.size());
+        decompressTimes.push_back(clock.getTimef());
+        compressedSize = pression::data::getDataSize(compressed);
+    }
+    if (info.errorBound == 0.f)
+        TESTINFO(result == data, info.name << " " << dataName);
+
+    return {info.name,
+            dataName,
+            chunkSize,
+            threads,
+            data.size(),
+            compressedSize,
+            _getStatistics(data.size(), compressTimes),
+            _getStatistics(data.size(), decompressTimes)};
+}
+
+void _writeJSON(std::ostream& os, const std::vector<Result>& results,
+                const size_t repetitions)
+{
+    os << "{" << std::endl
+       << "  \"repetitions\": " << repetitions << "," << std::endl
+       << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        os << (i == 0 ? "" : ",") << std::endl
+           << "    {\"engine\": \"" << result.engine << "\", \"data\": \""
+           << result.data << "\", \"chunkSize\": " << result.chunkSize
+           << ", \"threads\": " << result.threads
+           << ", \"size\": " << result.size
+           << ", \"compressedSize\": " << result.compressedSize
+           << ", \"ratio\": "
+           << float(result.compressedSize) / float(result.size)
+           << ", \"compressGBs\": {\"mean\": " << result.compress.mean
+           << ", \"stddev\": " << result.compress.stddev
+           << "}, \"decompressGBs\": {\"mean\": " << result.decompress.mean
+           << ", \"stddev\": " << result.decompress.stddev << "}}";
+    }
+    os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+}
+
+int main(const int argc, char** argv)
+{
+#ifdef PRESSION_USE_OPENMP
+    const int maxThreads = omp_get_max_threads();
+#else
+    const int maxThreads = 1;
+#endif
+    std::vector<int> threads{1};
+    if (maxThreads > 1)
+        threads.push_back(maxThreads);
+    std::vector<size_t> chunkSizes{0, LB_64KB, LB_1MB};
+    std::vector<std::string> engines;
+    std::vector<std::string> dataNames;
+    size_t sizeMB = 4;
+    size_t repetitions = 3;
+    std::string output("dataBenchmark.json");
+
+    po::options_description options("Data compressor benchmark suite");
+    options.add_options()("help,h", "Display usage information and exit")(
+        "engine,e", po::value(&engines)->multitoken(),
+        "Engine names to benchmark, default all lossless engines")(
+        "data,d", po::value(&dataNames)->multitoken(),
+        "Corpus data classes to benchmark, default all")(
+        "chunk-size,c", po::value(&chunkSizes)->multitoken(),
+        "Chunk sizes in bytes, 0 for the engine default")(
+        "threads,t", po::value(&threads)->multitoken(), "Thread counts")(
+        "size,s", po::value(&sizeMB), "Data size per class in MB")(
+        "repetitions,r", po::value(&repetitions), "Repetitions per run")(
+        "output,o", po::value(&output), "JSON output file, '-' for stdout");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv)
+                      .options(options)
+                      .allow_unregistered()
+                      .run(),
+                  vm);
+        po::notify(vm);
+    }
+    catch (std::exception& exception)
+    {
+        std::cerr << "Command line parse error: " << exception.what()
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << options << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const auto& infos = pression::data::Registry::getInstance().getInfos();
+    std::vector<Result> results;
+    if (dataNames.empty())
+        dataNames = corpus::getNames();
+
+    for (const auto& dataName : dataNames)
+    {
+        const Data data = corpus::generate(dataName, sizeMB * LB_1MB);
+
+        for (const auto& info : infos)
+        {
+            if (engines.empty() ? info.errorBound > 0.f
+                                : std::find(engines.begin(), engines.end(),
+                                            info.name) == engines.end())
+            {
+                continue;
+            }
+
+            for (const size_t chunkSize : chunkSizes)
+                for (const int nThreads : threads)
+                {
+                    results.push_back(_benchmark(info, dataName, data,
+                                                 chunkSize, nThreads,
+                                                 repetitions));
+                    const Result& result = results.back();
+                    std::cout << std::setw(8) << result.data << ", "
+                              << result.engine << ", " << std::setw(8)
+                              << result.chunkSize << ", " << std::setw(3)
+                              << result.threads << ", " << std::setw(10)
+                              << float(result.compressedSize) /
+                                     float(result.size)
+                              << ", " << std::setw(10) << result.compress.mean
+                              << ", " << std::setw(10)
+                              << result.decompress.mean << std::endl;
+                }
+        }
+    }
+
+    if (output == "-")
+        _writeJSON(std::cout, results, repetitions);
+    else
+    {
+        std::ofstream file(output);
+        _writeJSON(file, results, repetitions);
+        TESTINFO(file.good(), "Can't write " << output);
+    }
+    return EXIT_SUCCESS;
+}
@@ -19,25 +19,34 @@
 #define TEST_RUNTIME 600 // seconds
 #include <lunchbox/test.h>
 
+#include "corpus.h"
+
 #include <pression/data/Compressor.h>
+#include <pression/data/CompressorSZ.h>
 #include <pression/data/Registry.h>
 
 #include <lunchbox/buffer.h>
 #include <lunchbox/clock.h>
 #include <lunchbox/file.h>
 #include <lunchbox/memoryMap.h>
-#include <lunchbox/rng.h>
 
 #include <algorithm>
 #include <boost/program_options.hpp>
+#include <cmath>
+#include <stdexcept>
 
 using lunchbox::Strings;
 namespace po = boost::program_options;
 
 void _testFile(int argc, char** argv);
 void _testRandom();
+void _testFloat();
+void _testIndices();
+void _testChecksum();
+void _testStatistics();
+void _testErrorBound();
 void _testData(const std::string& name, uint8_t* data, uint64_t size);
-void getFiles(Strings& files, const std::string& ext);
+void _printTotal(const pression::data::CompressorInfo& info);
 
 pression::data::Registry& registry = pression::data::Registry::getInstance();
 uint64_t _result = 0;
@@ -50,14 +59,26 @@ int main(const int argc, char** argv)
 {
     _testFile(argc, argv);
     _testRandom();
+    _testFloat();
+    _testIndices();
+    _testChecksum();
+    _testStatistics();
+    _testErrorBound();
     return EXIT_SUCCESS;
 }
 
 pression::data::CompressorInfos getCompressors()
 {
     auto infos = registry.getInfos();
+    // lossy engines can't be verified bitwise, see _testErrorBound()
+    infos.erase(std::remove_if(infos.begin(), infos.end(),
+                               [](const pression::data::CompressorInfo& info) {
+                                   return info.errorBound > 0.f;
+                               }),
+                infos.end());
+
     for (auto i = infos.begin(); i != infos.end(); ++i)
-        if (i->name == "pression::data::CompressorRLE") // move RLE to front
+        if (i->name == "pression::data::CompressorRLE2") // move RLE to front
         {
             std::swap(*i, *infos.begin());
             return infos;
@@ -134,32 +155,17 @@ void _testFile(const int argc, char** argv)
     Strings files;
     if (vm.count("data"))
         files = vm["data"].as<Strings>();
-    else
-    {
-        getFiles(files, ".*\\.dll");
-        getFiles(files, ".*\\.exe");
-        getFiles(files, ".*\\.so");
-        getFiles(files, ".*\\.a");
-        getFiles(files, ".*\\.dylib");
-        getFiles(files, ".*\\.rgb");
-        getFiles(files, ".*\\.bin");
-        getFiles(files, ".*\\.ply");
-        getFiles(files, ".*\\.bbp");
-
-        // Limit to 30 files using a pseudo-random selection for reproducability
-        const size_t maxFiles = 30;
-        if (files.size() > maxFiles)
-        {
-            const size_t cut = files.size() - maxFiles;
-            for (size_t i = 0; i < cut; ++i)
-                files.erase(files.begin() + (i * 997 /*prime*/) % files.size());
-        }
-    }
 
     std::cout.setf(std::ios::right, std::ios::adjustfield);
     std::cout.precision(5);
     std::cout << "                File, Compressor, Uncompress, "
               << "Compressed,   comp GB/s, decomp GB/s" << std::endl;
+    const auto names = corpus::getNames();
+    std::vector<corpus::Data> corpus;
+    if (files.empty())
+        for (const auto& name : names)
+            corpus.push_back(corpus::generate(name, LB_10MB));
+
     const auto& infos = getCompressors();
     for (const auto& info : infos)
     {
@@ -180,6 +186,9 @@ void _testFile(const int argc, char** argv)
             const std::string name = lunchbox::getFilename(file);
             _testData(info, name, data, size);
         }
+        if (files.empty()) // same bytes on every machine
+            for (size_t i = 0; i < corpus.size(); ++i)
+                _testData(info, names[i], corpus[i].data(), corpus[i].size());
         if (_baseTime == 0.f)
             _baseTime = _compressionTime + _decompressionTime;
 
@@ -203,11 +212,8 @@ void _testFile(const int argc, char** argv)
 void _testRandom()
 {
     ssize_t size = LB_10MB;
-    uint8_t* data = new uint8_t[size];
-    lunchbox::RNG rng;
-#pragma omp parallel for
-    for (ssize_t i = 0; i < size; ++i)
-        data[i] = rng.get<uint8_t>();
+    const corpus::Data random = corpus::generate("random", size);
+    const uint8_t* data = random.data();
 
     const auto& infos = getCompressors();
     for (const auto& info : infos)
@@ -224,33 +230,229 @@ void _testRandom()
             _testData(info, "Random data", data, size);
             --size;
         }
-        std::cout << std::setw(22) << "Total, " << info.name
-                  << std::setfill(' ') << ", " << std::setw(10) << _size << ", "
-                  << std::setw(10) << _result << ", " << std::setw(10)
-                  << float(_size) * 1000.f / LB_1GB / _compressionTime << ", "
+        _printTotal(info);
+    }
+}
+
+void _testFloat()
+{
+    const size_t size = LB_10MB;
+    const corpus::Data floats = corpus::generate("float", size);
+    const corpus::Data doubles = corpus::generate("double", size);
+
+    const auto& infos = getCompressors();
+    for (const auto& info : infos)
+    {
+        _result = 0;
+        _size = 0;
+        _compressionTime = 0;
+        _decompressionTime = 0;
+
+        _testData(info, "Float data", floats.data(), size);
+        _testData(info, "Double data", doubles.data(), size);
+        _printTotal(info);
+    }
+}
+
+void _testIndices()
+{
+    const size_t size = LB_10MB;
+    const corpus::Data indices = corpus::generate("index", size);
+    const corpus::Data ids = corpus::generate("id", size);
+    const corpus::Data ids64 = corpus::generate("id64", size);
+
+    const auto& infos = getCompressors();
+    for (const auto& info : infos)
+    {
+        _result = 0;
+        _size = 0;
+        _compressionTime = 0;
+        _decompressionTime = 0;
+
+        _testData(info, "Index data", indices.data(), size);
+        _testData(info, "ID data", ids.data(), size);
+        _testData(info, "ID64 data", ids64.data(), size);
+        _printTotal(info);
+    }
+}
+
+bool _decompresses(pression::data::Compressor& compressor,
+                   const pression::data::Compressor::Results& compressed,
+                   uint8_t* data, const size_t size)
+{
+    try
+    {
+        compressor.decompress(compressed, data, size);
+    }
+    catch (const std::runtime_error&)
+    {
+        return false;
+    }
+    return true;
+}
+
+void _testChecksum()
+{
+    const size_t size = LB_10MB;
+    const corpus::Data floats = corpus::generate("float", size);
+    const uint8_t* data = floats.data();
+    pression::data::Compressor::Result result(size);
+
+    std::cout << std::endl
+              << "          Compressor, decomp GB/s, checked GB/s" << std::endl;
+    for (const auto& info : getCompressors())
+    {
+        std::unique_ptr<pression::data::Compressor> compressor(info.create());
+        float times[2];
+        for (const bool checksum : {false, true})
+        {
+            compressor->setChecksum(checksum);
+            const auto& compressed = compressor->compress(data, size);
+            compressor->decompress(compressed, result.getData(), size);
+
+            lunchbox::Clock clock;
+            compressor->decompress(compressed, result.getData(), size);
+            times[checksum] = clock.getTimef();
+            TEST(::memcmp(result.getData(), data, size) == 0);
+        }
+
+        // corrupt one byte of the compressed data and expect detection
+        auto compressed = compressor->getCompressedData();
+        auto& chunk = compressed[compressed.size() / 2];
+        chunk.getData()[chunk.getSize() / 2] ^= 0x10;
+        TESTINFO(!_decompresses(*compressor, compressed, result.getData(),
+                                size),
+                 info.name);
+
+        std::cout << std::setw(20) << info.name << ", " << std::setw(10)
+                  << float(size) * 1000.f / LB_1GB / times[0] << ", "
                   << std::setw(10)
-                  << float(_size) * 1000.f / LB_1GB / _decompressionTime
-                  << std::endl;
+                  << float(size) * 1000.f / LB_1GB / times[1] << std::endl;
     }
+}
+
+void _testStatistics()
+{
+    const size_t size = LB_1MB * 4;
+    const corpus::Data data = corpus::generate("rgba", size);
+    pression::data::Compressor::Result result(size);
+
+    for (const auto& info : getCompressors())
+    {
+        const auto before = registry.getStatistics(info.name);
+        std::unique_ptr<pression::data::Compressor> compressor(info.create());
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const auto& compressed = compressor->compress(data.data(), size);
+            compressor->decompress(compressed, result.getData(), size);
+        }
 
-    delete[] data;
+        const auto stats = compressor->getStatistics();
+        const size_t compressedSize =
+            pression::data::getDataSize(compressor->getCompressedData());
+        TESTINFO(stats.compress.calls == 3, info.name);
+        TESTINFO(stats.decompress.calls == 3, info.name);
+        TESTINFO(stats.compress.bytesIn == 3 * size, info.name);
+        TESTINFO(stats.compress.bytesOut == 3 * compressedSize, info.name);
+        TESTINFO(stats.decompress.bytesIn == 3 * compressedSize, info.name);
+        TESTINFO(stats.decompress.bytesOut == 3 * size, info.name);
+        TESTINFO(stats.compress.maxTime <= stats.compress.time, info.name);
+
+        uint64_t nChunks = 0;
+        for (const uint64_t chunks : stats.chunkRatios)
+            nChunks += chunks;
+        TESTINFO(nChunks == 3 * compressor->getCompressedData().size(),
+                 info.name);
+
+        // the engine aggregates all compressors it created
+        const auto after = registry.getStatistics(info.name);
+        TESTINFO(after.compress.calls == before.compress.calls + 3, info.name);
+        TESTINFO(after.decompress.bytesOut ==
+                     before.decompress.bytesOut + 3 * size,
+                 info.name);
+    }
 }
 
-void getFiles(Strings& files, const std::string& ext)
+template <typename T>
+void _testErrorBound(const std::vector<T>& values, const double errorBound)
 {
-    const Strings paths = {
-        {std::string(PRESSION_BUILD_DIR) + "/lib"},
-        {"../bin"},
-        {"../lib"},
-        {"../../install/bin"},
-        {"../../install/lib"},
-        {"images"},
-        {"/nfs4/bbp.epfl.ch/visualization/resources/meshes/mediumPly/"},
-        {"/nfs4/bbp.epfl.ch/visualization/circuits/KaustCircuit/meshes"},
-        {"/nfs4/bbp.epfl.ch/visualization/circuits/KaustCircuit/simulations/"
-         "run_1k/20.02.13/"}};
-
-    for (const auto& path : paths)
-        for (const auto& file : lunchbox::searchDirectory(path, ext))
-            files.push_back(path + '/' + file);
+    const size_t size = values.size() * sizeof(T);
+    const std::string name = pression::data::CompressorSZ<T>::getName();
+    std::unique_ptr<pression::data::Compressor> compressor(
+        registry.find(name).create());
+    TEST(compressor->setErrorBound(errorBound));
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(values.data());
+
+    compressor->compress(data, size);
+    lunchbox::Clock clock;
+    const auto& compressed = compressor->compress(data, size);
+    const float compressTime = clock.getTimef();
+
+    std::vector<T> result(values.size());
+    clock.reset();
+    compressor->decompress(compressed,
+                           reinterpret_cast<uint8_t*>(result.data()), size);
+    const float decompressTime = clock.getTimef();
+
+    double maxError = 0.;
+    for (size_t i = 0; i < values.size(); ++i)
+        maxError = std::max(maxError, std::abs(double(values[i]) - result[i]));
+    TESTINFO(maxError <= errorBound, maxError << " > " << errorBound);
+    const size_t compressedSize = pression::data::getDataSize(compressed);
+
+    // a chunk without quantization codes fails outside the parallel region
+    auto corrupt = compressor->getCompressedData();
+    auto& chunk = corrupt[corrupt.size() / 2];
+    ::memset(chunk.getData(), 0, chunk.getSize());
+    TESTINFO(!_decompresses(*compressor, corrupt,
+                            reinterpret_cast<uint8_t*>(result.data()), size),
+             name);
+
+    std::cout << std::setw(20) << name << ", " << std::setw(10) << errorBound
+              << ", " << std::setw(10) << maxError << ", " << std::setw(10)
+              << float(compressedSize) / float(size) << ", " << std::setw(10)
+              << float(size) * 1000.f / LB_1GB / compressTime << ", "
+              << std::setw(10)
+              << float(size) * 1000.f / LB_1GB / decompressTime << std::endl;
+}
+
+template <typename T>
+std::vector<T> _generate(const std::string& name)
+{
+    const corpus::Data data = corpus::generate(name, LB_10MB);
+    std::vector<T> values(data.size() / sizeof(T));
+    ::memcpy(values.data(), data.data(), values.size() * sizeof(T));
+    return values;
+}
+
+void _testErrorBound()
+{
+    const std::vector<float> floats = _generate<float>("float");
+    const std::vector<double> doubles = _generate<double>("double");
+
+    for (const auto& info : getCompressors()) // lossless engines ignore it
+    {
+        std::unique_ptr<pression::data::Compressor> compressor(info.create());
+        TESTINFO(!compressor->setErrorBound(1e-3), info.name);
+    }
+
+    std::cout << std::endl
+              << "          Compressor,      Bound,  Max error,      Ratio, "
+              << "  comp GB/s, decomp GB/s" << std::endl;
+    for (const double errorBound : {1e-1, 1e-2, 1e-3, 1e-4, 1e-5})
+    {
+        _testErrorBound(floats, errorBound);
+        _testErrorBound(doubles, errorBound);
+    }
+}
+
+void _printTotal(const pression::data::CompressorInfo& info)
+{
+    std::cout << std::setw(22) << "Total, " << info.name << std::setfill(' ')
+              << ", " << std::setw(10) << _size << ", " << std::setw(10)
+              << _result << ", " << std::setw(10)
+              << float(_size) * 1000.f / LB_1GB / _compressionTime << ", "
+              << std::setw(10)
+              << float(_size) * 1000.f / LB_1GB / _decompressionTime
+              << std::endl;
 }
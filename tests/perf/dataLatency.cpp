@@ -0,0 +1,125 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Measures the per-call latency distribution of all lossless engines for
+// small messages, as sent by a network transport.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+
+#include <pression/data/Compressor.h>
+#include <pression/data/CompressorInfo.h>
+#include <pression/data/Registry.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+const size_t _messageSizes[] = {64, 256, LB_1KB, LB_4KB, LB_16KB};
+const size_t _maxIterations = 20000;
+const size_t _maxBytes = LB_1MB * 32; // per engine and message size
+const size_t _corpusSize = LB_1MB;
+
+struct Percentiles
+{
+    float p50;
+    float p99;
+    float p999;
+    float max;
+};
+
+// @return percentiles of the given latencies in microseconds
+Percentiles _getPercentiles(std::vector<float>& latencies)
+{
+    std::sort(latencies.begin(), latencies.end());
+    const size_t n = latencies.size();
+    return {latencies[n / 2], latencies[n * 99 / 100],
+            latencies[n * 999 / 1000], latencies.back()};
+}
+
+float _getMicroseconds(const Clock::time_point& start)
+{
+    return std::chrono::duration<float, std::micro>(Clock::now() - start)
+        .count();
+}
+
+void _print(const Percentiles& percentiles)
+{
+    std::cout << ", " << std::setw(8) << percentiles.p50 << ", "
+              << std::setw(8) << percentiles.p99 << ", " << std::setw(8)
+              << percentiles.p999 << ", " << std::setw(8) << percentiles.max;
+}
+
+void _testLatency(const pression::data::CompressorInfo& info,
+                  const corpus::Data& data, const size_t messageSize)
+{
+    std::unique_ptr<pression::data::Compressor> compressor(info.create());
+    const size_t nIterations =
+        std::min(_maxIterations, _maxBytes / messageSize);
+    std::vector<float> compressLatencies(nIterations);
+    std::vector<float> decompressLatencies(nIterations);
+    std::vector<uint8_t> result(messageSize);
+    size_t compressedSize = 0;
+
+    for (size_t i = 0; i < nIterations; ++i)
+    {
+        // consecutive messages from the corpus, as a stream would send them
+        const size_t offset = (i * messageSize) % (data.size() - messageSize);
+        const uint8_t* message = data.data() + offset;
+
+        Clock::time_point start = Clock::now();
+        const auto& compressed = compressor->compress(message, messageSize);
+        compressLatencies[i] = _getMicroseconds(start);
+
+        start = Clock::now();
+        compressor->decompress(compressed, result.data(), messageSize);
+        decompressLatencies[i] = _getMicroseconds(start);
+
+        TEST(::memcmp(result.data(), message, messageSize) == 0);
+        compressedSize += pression::data::getDataSize(compressed);
+    }
+
+    std::cout << std::setw(20) << info.name << ", " << std::setw(6)
+              << messageSize << ", " << std::setw(8)
+              << float(compressedSize) / float(nIterations * messageSize);
+    _print(_getPercentiles(compressLatencies));
+    _print(_getPercentiles(decompressLatencies));
+    std::cout << std::endl;
+}
+}
+
+int main(int, char**)
+{
+    const corpus::Data data = corpus::generate("text", _corpusSize);
+
+    std::cout << "          Compressor,   Size,    Ratio, comp p50,      p99,"
+              << "     p999,      max, decomp p50,    p99,     p999,      max"
+              << " [us]" << std::endl;
+    for (const auto& info :
+         pression::data::Registry::getInstance().getInfos())
+    {
+        if (info.errorBound > 0.f)
+            continue;
+        for (const size_t messageSize : _messageSizes)
+            _testLatency(info, data, messageSize);
+    }
+    return EXIT_SUCCESS;
+}
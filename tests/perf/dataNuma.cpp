@@ -0,0 +1,142 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Compares throughput for data first-touched by the worker which processes it
+// ("local") against data first-touched by the mirrored worker ("remote"). With
+// one worker per core, the mirrored worker runs on the other socket of a
+// two-socket node. Only the fast engines are measured, the slower ones are
+// bound by computation rather than by memory placement.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+
+#include <pression/data/Compressor.h>
+#include <pression/data/CompressorInfo.h>
+#include <pression/data/Registry.h>
+
+#include <lunchbox/clock.h>
+#include <lunchbox/thread.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#ifdef PRESSION_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+const size_t _size = LB_10MB * 4; // larger than the last level caches
+const size_t _repetitions = 5;
+const float _minSpeed = .15f; // relative to RLE, see CompressorInfo::speed
+
+int _getThreadNum()
+{
+#ifdef PRESSION_USE_OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+int _getNumThreads()
+{
+#ifdef PRESSION_USE_OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+// Allocate without touching, then let each worker touch its block. Workers
+// are pinned like in Compressor::setAffinity(), which never pins thread 0.
+uint8_t* _allocate(const bool remote, const corpus::Data* source)
+{
+    uint8_t* data = new uint8_t[_size];
+#pragma omp parallel
+    {
+        const int nThreads = _getNumThreads();
+        const int thread = _getThreadNum();
+        const int owner = remote ? nThreads - 1 - thread : thread;
+        const size_t start = _size * owner / nThreads;
+        const size_t end = _size * (owner + 1) / nThreads;
+
+        if (thread > 0)
+            lunchbox::Thread::setAffinity(lunchbox::Thread::CORE + thread);
+        if (source)
+            ::memcpy(data + start, source->data() + start, end - start);
+        else
+            ::memset(data + start, 0, end - start);
+    }
+    return data;
+}
+
+float _median(std::vector<float>& times)
+{
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+void _testPlacement(const pression::data::CompressorInfo& info,
+                    const bool remote)
+{
+    std::unique_ptr<pression::data::Compressor> compressor(info.create());
+    compressor->setAffinity(true);
+
+    const corpus::Data source = corpus::generate("float", _size);
+    std::unique_ptr<uint8_t[]> data(_allocate(remote, &source));
+    std::unique_ptr<uint8_t[]> result(_allocate(remote, nullptr));
+    std::vector<float> compressTimes;
+    std::vector<float> decompressTimes;
+
+    compressor->compress(data.get(), _size); // first-touch output
+    for (size_t i = 0; i < _repetitions; ++i)
+    {
+        lunchbox::Clock clock;
+        const auto& compressed = compressor->compress(data.get(), _size);
+        compressTimes.push_back(clock.getTimef());
+
+        clock.reset();
+        compressor->decompress(compressed, result.get(), _size);
+        decompressTimes.push_back(clock.getTimef());
+    }
+    TEST(::memcmp(data.get(), result.get(), _size) == 0);
+
+    std::cout << std::setw(20) << info.name << ", " << std::setw(8)
+              << (remote ? "remote" : "local") << ", " << std::setw(10)
+              << float(_size) * 1000.f / LB_1GB / _median(compressTimes)
+              << ", " << std::setw(10)
+              << float(_size) * 1000.f / LB_1GB / _median(decompressTimes)
+              << std::endl;
+}
+}
+
+int main(int, char**)
+{
+    std::cout << "          Compressor, placement,  comp GB/s, decomp GB/s"
+              << std::endl;
+    for (const auto& info :
+         pression::data::Registry::getInstance().getInfos())
+    {
+        if (info.errorBound > 0.f || info.speed < _minSpeed)
+            continue;
+        _testPlacement(info, false);
+        _testPlacement(info, true);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,283 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Performance regression gate: compares the compression ratio and the
+// single-threaded speed of all lossless engines on the synthetic corpus
+// against dataRegression.baseline. Speeds are measured relative to memcpy on
+// the same machine, so the baseline applies to different hosts. Fails if an
+// engine compresses worse or runs slower than the baseline allows, and if the
+// measured engines and the baseline entries do not match. Lossy engines and
+// the optional engines listed in _ungatedNames are not measured. Use --update
+// to record a new baseline after intended changes.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+
+#include <pression/data/Compressor.h>
+#include <pression/data/CompressorInfo.h>
+#include <pression/data/Registry.h>
+
+#include <lunchbox/clock.h>
+
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#ifdef PRESSION_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace po = boost::program_options;
+
+namespace
+{
+const size_t _size = LB_1MB * 2;
+const size_t _repetitions = 5;
+const size_t _memcpyRepetitions = 100; // short, hence more sensitive to noise
+const char* const _dataNames[] = {"rgba", "depth", "float", "index", "text"};
+
+// Optional engines without a recorded baseline, which are not gated. Record
+// their baseline using --update on a build which has them, then remove them.
+const char* const _ungatedNames[] = {"pression::data::CompressorSnappy"};
+
+struct Result
+{
+    float ratio;
+    float compress;   // speed relative to memcpy
+    float decompress; // speed relative to memcpy
+};
+typedef std::map<std::string, Result> Results; // "engine data" -> result
+
+float _getMemcpyTime(const corpus::Data& data)
+{
+    corpus::Data copy(data.size());
+    float time = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < _memcpyRepetitions; ++i)
+    {
+        lunchbox::Clock clock;
+        ::memcpy(copy.data(), data.data(), data.size());
+        time = std::min(time, clock.getTimef());
+    }
+    TEST(copy == data);
+    return std::max(time, 1e-6f);
+}
+
+// best of all repetitions, the most stable estimate on a shared machine
+Result _measure(const pression::data::CompressorInfo& info,
+                const corpus::Data& data, const float memcpyTime)
+{
+    std::unique_ptr<pression::data::Compressor> compressor(info.create());
+    corpus::Data result(data.size());
+    float compressTime = std::numeric_limits<float>::max();
+    float decompressTime = std::numeric_limits<float>::max();
+    size_t compressedSize = 0;
+
+    compressor->compress(data.data(), data.size()); // warm up
+    for (size_t i = 0; i < _repetitions; ++i)
+    {
+        lunchbox::Clock clock;
+        const auto& compressed = compressor->compress(data.data(), data.size());
+        compressTime = std::min(compressTime, clock.getTimef());
+
+        clock.reset();
+        compressor->decompress(compressed, result.data(), result.size());
+        decompressTime = std::min(decompressTime, clock.getTimef());
+        compressedSize = pression::data::getDataSize(compressed);
+    }
+    TESTINFO(result == data, info.name);
+
+    return {float(compressedSize) / float(data.size()),
+            memcpyTime / std::max(compressTime, 1e-6f),
+            memcpyTime / std::max(decompressTime, 1e-6f)};
+}
+
+Results _read(const std::string& filename)
+{
+    std::ifstream file(filename);
+    TESTINFO(file.is_open(), "Can't open baseline " << filename);
+
+    Results results;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream is(line);
+        std::string engine, data;
+        Result result;
+        is >> engine >> data >> result.ratio >> result.compress >>
+            result.decompress;
+        TESTINFO(!is.fail(), "Malformed baseline line: " << line);
+        results[engine + " " + data] = result;
+    }
+    return results;
+}
+
+void _write(const std::string& filename, const Results& results)
+{
+    std::ofstream file(filename);
+    file << "# Pression data compressor performance baseline, generated by\n"
+         << "# dataRegression --update. Speeds are relative to memcpy.\n"
+         << "# engine data ratio compress decompress" << std::endl;
+    for (const auto& i : results)
+        file << i.first << " " << i.second.ratio << " " << i.second.compress
+             << " " << i.second.decompress << std::endl;
+    TESTINFO(file.good(), "Can't write " << filename);
+}
+
+bool _isGated(const pression::data::CompressorInfo& info)
+{
+    for (const char* name : _ungatedNames)
+        if (info.name == name)
+            return false;
+    return true;
+}
+
+// @return true if the measured speed is within the tolerance of the baseline
+bool _check(const std::string& name, const char* what, const float speed,
+            const float baseline, const float tolerance)
+{
+    if (speed >= baseline * (1.f - tolerance))
+        return true;
+    std::cerr << "Regression: " << name << " " << what << " speed " << speed
+              << " below baseline " << baseline << std::endl;
+    return false;
+}
+}
+
+int main(const int argc, char** argv)
+{
+    std::string baseline(PRESSION_TEST_DIR "perf/dataRegression.baseline");
+    float tolerance = 0.5f;
+    float ratioTolerance = 0.01f;
+
+    po::options_description options("Data compressor regression gate");
+    options.add_options()("help,h", "Display usage information and exit")(
+        "baseline,b", po::value(&baseline), "Baseline file")(
+        "tolerance,t", po::value(&tolerance),
+        "Tolerated relative speed loss")(
+        "ratio-tolerance,r", po::value(&ratioTolerance),
+        "Tolerated relative compression ratio loss")(
+        "update,u", "Write the measured results as new baseline");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv)
+                      .options(options)
+                      .allow_unregistered()
+                      .run(),
+                  vm);
+        po::notify(vm);
+    }
+    catch (std::exception& exception)
+    {
+        std::cerr << "Command line parse error: " << exception.what()
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << options << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+#ifdef PRESSION_USE_OPENMP
+    omp_set_num_threads(1); // pinned to one thread for comparable speeds
+#endif
+    Results results;
+    for (const char* dataName : _dataNames)
+    {
+        const corpus::Data data = corpus::generate(dataName, _size);
+        const float memcpyTime = _getMemcpyTime(data);
+
+        for (const auto& info :
+             pression::data::Registry::getInstance().getInfos())
+        {
+            if (info.errorBound == 0.f && _isGated(info))
+                results[info.name + " " + dataName] =
+                    _measure(info, data, memcpyTime);
+        }
+    }
+
+    if (vm.count("update"))
+    {
+        _write(baseline, results);
+        std::cout << "Wrote " << results.size() << " results to " << baseline
+                  << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const Results expected = _read(baseline);
+    size_t nRegressions = 0;
+    std::cout << std::setw(42) << "Engine and data"
+              << ", Ratio, Compress, Decompress [x memcpy], baseline"
+              << std::endl;
+    for (const auto& i : results)
+    {
+        const auto j = expected.find(i.first);
+        const Result& result = i.second;
+        std::cout << std::setw(42) << i.first << ", " << std::setw(6)
+                  << result.ratio << ", " << std::setw(8) << result.compress
+                  << ", " << std::setw(8) << result.decompress;
+        if (j == expected.end())
+        {
+            std::cout << ", no baseline" << std::endl;
+            std::cerr << "Missing baseline: " << i.first
+                      << ", run with --update" << std::endl;
+            ++nRegressions;
+            continue;
+        }
+
+        const Result& base = j->second;
+        std::cout << ", " << base.ratio << ", " << base.compress << ", "
+                  << base.decompress << std::endl;
+        if (result.ratio > base.ratio * (1.f + ratioTolerance))
+        {
+            std::cerr << "Regression: " << i.first << " ratio "
+                      << result.ratio << " above baseline " << base.ratio
+                      << std::endl;
+            ++nRegressions;
+        }
+        if (!_check(i.first, "compress", result.compress, base.compress,
+                    tolerance))
+        {
+            ++nRegressions;
+        }
+        if (!_check(i.first, "decompress", result.decompress,
+                    base.decompress, tolerance))
+        {
+            ++nRegressions;
+        }
+    }
+
+    for (const auto& i : expected)
+    {
+        if (results.find(i.first) == results.end())
+        {
+            std::cerr << "Stale baseline: " << i.first
+                      << " was not measured, run with --update" << std::endl;
+            ++nRegressions;
+        }
+    }
+
+    TESTINFO(nRegressions == 0, nRegressions << " performance regressions");
+    return EXIT_SUCCESS;
+}
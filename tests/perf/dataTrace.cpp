@@ -0,0 +1,92 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Traces one compress and decompress operation of all lossless engines and
+// writes the per-chunk trace to dataTrace.json, to be loaded in
+// chrome://tracing. Without PRESSION_TRACE it checks that nothing is recorded.
+
+#define TEST_RUNTIME 600 // seconds
+#include <lunchbox/test.h>
+
+#include "corpus.h"
+
+#include <pression/data/Compressor.h>
+#include <pression/data/CompressorInfo.h>
+#include <pression/data/Registry.h>
+#include <pression/data/Trace.h>
+
+#include <sstream>
+
+namespace
+{
+const size_t _size = LB_1MB * 16;
+
+size_t _count(const std::string& string, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t i = string.find(pattern); i != std::string::npos;
+         i = string.find(pattern, i + pattern.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+}
+
+int main(int, char**)
+{
+    using pression::data::Trace;
+    const corpus::Data data = corpus::generate("float", _size);
+    std::vector<uint8_t> result(_size);
+    size_t nChunks = 0;
+
+    Trace::clear();
+    Trace::setEnabled(true);
+    for (const auto& info :
+         pression::data::Registry::getInstance().getInfos())
+    {
+        if (info.errorBound > 0.f)
+            continue;
+
+        std::unique_ptr<pression::data::Compressor> compressor(info.create());
+        const auto& compressed = compressor->compress(data.data(), _size);
+        compressor->decompress(compressed, result.data(), _size);
+        TESTINFO(result == data, info.name);
+        nChunks += compressed.size();
+    }
+    Trace::setEnabled(false);
+
+    std::ostringstream os;
+    Trace::write(os);
+    const std::string json = os.str();
+
+    if (!Trace::isSupported())
+    {
+        TEST(Trace::getSize() == 0);
+        std::cout << "Tracing not supported, build with PRESSION_TRACE"
+                  << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    TEST(_count(json, "\"name\": \"compressChunk\"") == nChunks);
+    TEST(_count(json, "\"name\": \"decompressChunk\"") == nChunks);
+    TEST(_count(json, "\"ph\": \"X\"") == Trace::getSize());
+
+    Trace::write("dataTrace.json");
+    std::cout << Trace::getSize() << " events written to dataTrace.json"
+              << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+/* Copyright (c) 2016, Stefan.Eilemann@epfl.ch
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <lunchbox/test.h>
+#include <pression/plugins/compressor.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Helpers for tests of the image compression engines.
+ *
+ * The engines are used through the plugin API, the same way as by
+ * applications loading the compressor DSO.
+ */
+namespace plugin
+{
+typedef std::chrono::high_resolution_clock Clock;
+
+/** @return the milliseconds elapsed since start. */
+inline float getMilliseconds(const Clock::time_point& start)
+{
+    return std::chrono::duration<float, std::milli>(Clock::now() - start)
+        .count();
+}
+
+/** The results of one compression, valid until the next compression. */
+struct Compressed
+{
+    Compressed()
+        : size(0)
+        , time(0.f)
+    {
+    }
+
+    std::vector<const void*> data;
+    std::vector<eq_uint64_t> sizes;
+    eq_uint64_t size; //!< the sum of all result sizes
+    float time;       //!< the compression time in milliseconds
+};
+
+/** The compression ratio and speed of one round trip. */
+struct Result
+{
+    float ratio;
+    float compressTime;   //!< milliseconds
+    float decompressTime; //!< milliseconds
+};
+
+/** Image and buffer sizes which are no multiple of any tile or vector size. */
+const eq_uint64_t oddSizes[][2] = {{1, 1},  {3, 1},  {1, 3},   {2, 2},
+                                   {7, 5},  {17, 9}, {129, 33}, {513, 3},
+                                   {1921, 7}};
+
+/** Compress the input with an existing compressor instance. */
+inline Compressed compress(void* const compressor, const unsigned name,
+                           const void* const input, eq_uint64_t dims[4],
+                           const eq_uint64_t flags)
+{
+    Compressed compressed;
+    const Clock::time_point start = Clock::now();
+    EqCompressorCompress(compressor, name, const_cast<void*>(input), dims,
+                         flags);
+    compressed.time = getMilliseconds(start);
+
+    const unsigned nResults = EqCompressorGetNumResults(compressor, name);
+    for (unsigned i = 0; i < nResults; ++i)
+    {
+        void* data;
+        eq_uint64_t size;
+        EqCompressorGetResult(compressor, name, i, &data, &size);
+        compressed.data.push_back(data);
+        compressed.sizes.push_back(size);
+        compressed.size += size;
+    }
+    return compressed;
+}
+
+/**
+ * Decompress the results of compress().
+ *
+ * @return the decompression time in milliseconds
+ */
+inline float decompress(void* const decompressor, const unsigned name,
+                        const Compressed& compressed, void* const output,
+                        eq_uint64_t dims[4], const eq_uint64_t flags)
+{
+    const Clock::time_point start = Clock::now();
+    EqCompressorDecompress(decompressor, name, compressed.data.data(),
+                           compressed.sizes.data(),
+                           unsigned(compressed.data.size()), output, dims,
+                           flags);
+    return getMilliseconds(start);
+}
+
+/**
+ * Compress and decompress the input with new instances of the given engine.
+ *
+ * @param name the engine
+ * @param input the uncompressed data of width * height pixels
+ * @param output the decompressed data, resized to the input size
+ * @param width the number of pixels per row, or of all pixels for 1D data
+ * @param height the number of rows, 1 for 1D data
+ * @param flags the compression flags, containing EQ_COMPRESSOR_DATA_1D or
+ *              EQ_COMPRESSOR_DATA_2D
+ * @return the compression ratio and timings
+ */
+template <typename T>
+Result roundTrip(const unsigned name, const std::vector<T>& input,
+                 std::vector<T>& output, const eq_uint64_t width,
+                 const eq_uint64_t height, const eq_uint64_t flags)
+{
+    void* compressor = EqCompressorNewCompressor(name);
+    void* decompressor = EqCompressorNewDecompressor(name);
+    TESTINFO(compressor, "0x" << std::hex << name);
+
+    eq_uint64_t dims[4] = {0, width, 0, height};
+    const Compressed compressed =
+        compress(compressor, name, input.data(), dims, flags);
+
+    output.assign(input.size(), T());
+    const float decompressTime =
+        decompress(decompressor, name, compressed, output.data(), dims, flags);
+    EqCompressorDeleteCompressor(compressor);
+    EqCompressorDeleteDecompressor(decompressor);
+
+    return {float(compressed.size) / float(input.size() * sizeof(T)),
+            compressed.time, decompressTime};
+}
+
+/**
+ * Round trip the first values of the data as images and as 1D buffers of all
+ * oddSizes, and check that the engine is lossless for them.
+ *
+ * @param name the engine
+ * @param data the values to compress, at least channels times the largest
+ *             image size
+ * @param channels the number of values per pixel
+ */
+template <typename T>
+void testOddSizes(const unsigned name, const std::vector<T>& data,
+                  const size_t channels)
+{
+    for (const auto& size : oddSizes)
+        for (const eq_uint64_t flags : {eq_uint64_t(EQ_COMPRESSOR_DATA_2D),
+                                        eq_uint64_t(EQ_COMPRESSOR_DATA_1D)})
+        {
+            const bool is1D = flags & EQ_COMPRESSOR_DATA_1D;
+            const eq_uint64_t width = is1D ? size[0] * size[1] : size[0];
+            const eq_uint64_t height = is1D ? 1 : size[1];
+            const size_t nValues = width * height * channels;
+            TEST(data.size() >= nValues);
+
+            const std::vector<T> input(data.begin(), data.begin() + nValues);
+            std::vector<T> output;
+            roundTrip(name, input, output, width, height, flags);
+            TESTINFO(::memcmp(output.data(), input.data(),
+                              nValues * sizeof(T)) == 0,
+                     "0x" << std::hex << name << std::dec << " " << width
+                          << "x" << height << (is1D ? " 1D" : ""));
+        }
+}
+
+/** Print the ratio and the speed of a round trip of the given data size. */
+inline void print(const unsigned name, const std::string& label,
+                  const Result& result, const size_t bytes)
+{
+    const float mBytes = float(bytes) / 1000.f;
+    std::cout << "0x" << std::hex << name << std::dec << label << ": ratio "
+              << result.ratio << ", " << mBytes / result.compressTime
+              << " MB/s compress, " << mBytes / result.decompressTime
+              << " MB/s decompress" << std::endl;
+}
+}